@@ -0,0 +1,120 @@
+#include "allocationcounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+struct AtomicCounters {
+    std::atomic<std::size_t> allocations{};
+    std::atomic<std::size_t> deallocations{};
+    std::atomic<std::size_t> bytes{};
+
+    void allocated(std::size_t size) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void deallocated() {
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] allocations::Counters load() const {
+        return {allocations.load(std::memory_order_relaxed), deallocations.load(std::memory_order_relaxed),
+                bytes.load(std::memory_order_relaxed)};
+    }
+};
+
+// constant-initialized, so they are ready before any static constructor allocates
+constinit AtomicCounters heapCounters;
+constinit AtomicCounters myStringCounters;
+
+} // namespace
+
+
+namespace allocations {
+
+Counters heap() {
+    return heapCounters.load();
+}
+
+Counters myString() {
+    return myStringCounters.load();
+}
+
+void recordMyStringAllocation(std::size_t bytes) {
+    if constexpr (enabled())
+        myStringCounters.allocated(bytes);
+}
+
+void recordMyStringDeallocation() {
+    if constexpr (enabled())
+        myStringCounters.deallocated();
+}
+
+} // namespace allocations
+
+
+#ifdef MYSTRING_COUNT_ALLOCATIONS
+// Replacements of the global operators. All non-aligned forms are replaced together,
+// so memory is never released by a different allocator than the one which gave it (sanitizers check it).
+// The aligned forms are not counted.
+
+namespace {
+
+void* countedMalloc(std::size_t size) noexcept {
+    heapCounters.allocated(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void countedFree(void* memory) noexcept {
+    if (memory)
+        heapCounters.deallocated();
+    std::free(memory);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* memory = countedMalloc(size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedMalloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedMalloc(size);
+}
+
+void operator delete(void* memory) noexcept {
+    countedFree(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    countedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    countedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    countedFree(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    countedFree(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    countedFree(memory);
+}
+#endif
@@ -0,0 +1,82 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+#include <memory>
+
+
+/// Heap allocation statistics, collected only in builds with MYSTRING_COUNT_ALLOCATIONS defined
+/// (the tests target and the word-count benchmark). Otherwise enabled() is false and all counters stay 0.
+/// The counters are process-wide.
+namespace allocations {
+
+struct Counters {
+    std::size_t allocations{};
+    std::size_t deallocations{};
+    std::size_t bytes{}; ///< requested by the allocations
+
+    [[nodiscard]] Counters operator-(const Counters& earlier) const {
+        return {allocations - earlier.allocations, deallocations - earlier.deallocations, bytes - earlier.bytes};
+    }
+};
+
+[[nodiscard]] constexpr bool enabled() {
+#ifdef MYSTRING_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// All calls of the global operator new / delete.
+[[nodiscard]] Counters heap();
+/// Only the heap parts of MyString objects (a subset of heap()).
+[[nodiscard]] Counters myString();
+
+void recordMyStringAllocation(std::size_t bytes);
+void recordMyStringDeallocation();
+
+/// Counts what was allocated between its construction and the calls of heap() / myString().
+class Scope {
+public:
+    Scope() : heapStart_(allocations::heap()), myStringStart_(allocations::myString()) {}
+
+    [[nodiscard]] Counters heap() const { return allocations::heap() - heapStart_; }
+    [[nodiscard]] Counters myString() const { return allocations::myString() - myStringStart_; }
+
+private:
+    Counters heapStart_;
+    Counters myStringStart_;
+};
+
+/// std::allocator reporting to myString() - used for the heap part of MyString when counting is enabled.
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    constexpr CountingAllocator() = default;
+    template<typename U>
+    constexpr CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    /// Allocations made during constant evaluation (constexpr MyString) are not counted.
+    constexpr T* allocate(std::size_t count) {
+        if !consteval {
+            recordMyStringAllocation(count * sizeof(T));
+        }
+        return std::allocator<T>{}.allocate(count);
+    }
+
+    constexpr void deallocate(T* memory, std::size_t count) noexcept {
+        if !consteval {
+            recordMyStringDeallocation();
+        }
+        std::allocator<T>{}.deallocate(memory, count);
+    }
+
+    friend constexpr bool operator==(const CountingAllocator&, const CountingAllocator&) { return true; }
+};
+
+} // namespace allocations
+
+
+#endif //ALLOCATIONCOUNTER_H
@@ -0,0 +1,104 @@
+#include "asciikernels.h"
+
+#include <bit>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr char caseBit = 0x20;
+
+/// Flips the case bit of every byte in [First, Last] (compare-and-xor, 16 bytes per step).
+template<char First, char Last>
+void flipCaseInRange(const char* source, char* destination, std::size_t length) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i belowRange = _mm_set1_epi8(static_cast<char>(First - 1));
+    const __m128i aboveRange = _mm_set1_epi8(static_cast<char>(Last + 1));
+    const __m128i bit = _mm_set1_epi8(caseBit);
+    const bool inPlace = source == destination;
+
+    for (; i + 16 <= length; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        // bytes >= 0x80 are negative for the signed compare, so they are never in range
+        const __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(chunk, belowRange),
+                                              _mm_cmplt_epi8(chunk, aboveRange));
+        if (inPlace && _mm_movemask_epi8(inRange) == 0)
+            continue; // nothing to convert - skip the store
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i),
+                         _mm_xor_si128(chunk, _mm_and_si128(inRange, bit)));
+    }
+#endif
+    for (; i < length; ++i) {
+        const char ch = source[i];
+        destination[i] = (First <= ch && ch <= Last) ? static_cast<char>(ch ^ caseBit) : ch;
+    }
+}
+
+constexpr bool isWhitespace(char ch) {
+    return ch == ' ' || ('\t' <= ch && ch <= '\r');
+}
+
+#if defined(__SSE2__)
+/// Bit i is set when byte i of the chunk is whitespace.
+unsigned whitespaceMask(const char* data) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const __m128i space = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '));
+    const __m128i control = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('\t' - 1)),
+                                          _mm_cmplt_epi8(chunk, _mm_set1_epi8('\r' + 1)));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(space, control)));
+}
+#endif
+
+} // namespace
+
+namespace ascii {
+
+void toLower(char* data, std::size_t length) {
+    flipCaseInRange<'A', 'Z'>(data, data, length);
+}
+
+void toUpper(char* data, std::size_t length) {
+    flipCaseInRange<'a', 'z'>(data, data, length);
+}
+
+void toLowerCopy(const char* source, char* destination, std::size_t length) {
+    flipCaseInRange<'A', 'Z'>(source, destination, length);
+}
+
+void toUpperCopy(const char* source, char* destination, std::size_t length) {
+    flipCaseInRange<'a', 'z'>(source, destination, length);
+}
+
+
+std::size_t skipWhitespace(const char* data, std::size_t length) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= length; i += 16) {
+        const unsigned nonWhitespace = ~whitespaceMask(data + i) & 0xFFFFu;
+        if (nonWhitespace != 0)
+            return i + std::countr_zero(nonWhitespace);
+    }
+#endif
+    while (i < length && isWhitespace(data[i]))
+        ++i;
+    return i;
+}
+
+std::size_t skipWhitespaceBackward(const char* data, std::size_t length) {
+    std::size_t end = length;
+#if defined(__SSE2__)
+    for (; end >= 16; end -= 16) {
+        const unsigned nonWhitespace = ~whitespaceMask(data + end - 16) & 0xFFFFu;
+        if (nonWhitespace != 0)
+            return end - 16 + std::bit_width(nonWhitespace);
+    }
+#endif
+    while (end > 0 && isWhitespace(data[end - 1]))
+        --end;
+    return end;
+}
+
+} // namespace ascii
@@ -0,0 +1,25 @@
+#ifndef ASCIIKERNELS_H
+#define ASCIIKERNELS_H
+
+#include <cstddef>
+
+/// Byte-wise ASCII kernels working on raw buffers (SSE2 when available, scalar otherwise).
+/// Bytes outside 'A'-'Z'/'a'-'z' are never modified.
+namespace ascii {
+
+void toLower(char* data, std::size_t length);
+void toUpper(char* data, std::size_t length);
+
+/// source and destination may be the same buffer, but must not overlap otherwise.
+void toLowerCopy(const char* source, char* destination, std::size_t length);
+void toUpperCopy(const char* source, char* destination, std::size_t length);
+
+/// Whitespace as in std::isspace for the "C" locale: ' ', '\t', '\n', '\v', '\f', '\r'.
+/// @return index of the first non-whitespace byte, or length when there is none
+std::size_t skipWhitespace(const char* data, std::size_t length);
+/// @return length of data after dropping trailing whitespace (0 when all bytes are whitespace)
+std::size_t skipWhitespaceBackward(const char* data, std::size_t length);
+
+} // namespace ascii
+
+#endif //ASCIIKERNELS_H
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "corpusgenerator.h"
+#include "mystring.h"
+#include "perfprobe.h"
+#include "wordtokenizer.h"
+
+namespace {
+
+void BM_CorpusGenerate(benchmark::State& state) {
+    CorpusGenerator generator;
+    const auto length = static_cast<std::size_t>(state.range(0));
+    for (auto _: state)
+        benchmark::DoNotOptimize(generator.generate(length));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * length));
+}
+BENCHMARK(BM_CorpusGenerate)->Arg(1 << 20)->Arg(1 << 26)->Unit(benchmark::kMillisecond);
+
+void BM_CountWordsUsageIgnoringCases(benchmark::State& state) {
+    CorpusOptions options;
+    options.vocabularySize = static_cast<std::size_t>(state.range(0));
+    const MyString text = CorpusGenerator(options).generate(16 << 20);
+    std::size_t words = 0;
+    forEachWord<charclass::letters>(text, [&](std::string_view) { ++words; });
+
+    PerfReading counters;
+    for (auto _: state) {
+        PerfProbe probe(counters);
+        benchmark::DoNotOptimize(text.countWordsUsageIgnoringCases());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+
+    // per map insert (= word): shows how much of the time goes to cache misses in the std::map
+    const auto perWord = static_cast<double>(state.iterations() * words);
+    if (PerfCounters::hardwareAvailable()) {
+        state.counters["cycles/word"] = static_cast<double>(counters.cycles) / perWord;
+        state.counters["cache-misses/word"] = static_cast<double>(counters.cacheMisses) / perWord;
+        state.counters["branch-misses/word"] = static_cast<double>(counters.branchMisses) / perWord;
+        state.counters["IPC"] = counters.instructionsPerCycle();
+    } else {
+        state.counters["task-ns/word"] = static_cast<double>(counters.taskClockNs) / perWord;
+    }
+}
+BENCHMARK(BM_CountWordsUsageIgnoringCases)->Arg(1'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+void BM_GetUniqueWords(benchmark::State& state) {
+    CorpusOptions options;
+    options.vocabularySize = static_cast<std::size_t>(state.range(0));
+    const MyString text = CorpusGenerator(options).generate(16 << 20);
+    for (auto _: state)
+        benchmark::DoNotOptimize(text.getUniqueWords());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_GetUniqueWords)->Arg(1'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,66 @@
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "corpusgenerator.h"
+#include "linebatch.h"
+#include "mystring.h"
+
+namespace {
+
+/// Corpus with lines of about 50 characters.
+const std::string& linesText() {
+    static const std::string text = [] {
+        CorpusOptions options;
+        options.newlineProbability = 0.1;
+        return CorpusGenerator(options).generate(32 << 20).toString();
+    }();
+    return text;
+}
+
+void BM_ReadLinesOperatorExtraction(benchmark::State& state) {
+    const std::string& text = linesText();
+    for (auto _: state) {
+        std::istringstream in(text);
+        MyString line;
+        std::size_t lines = 0;
+        while (in >> line)
+            ++lines;
+        benchmark::DoNotOptimize(lines);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ReadLinesOperatorExtraction)->Unit(benchmark::kMillisecond);
+
+void BM_ReadLinesStdGetline(benchmark::State& state) {
+    const std::string& text = linesText();
+    for (auto _: state) {
+        std::istringstream in(text);
+        std::string line;
+        std::size_t lines = 0;
+        while (std::getline(in, line))
+            ++lines;
+        benchmark::DoNotOptimize(lines);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ReadLinesStdGetline)->Unit(benchmark::kMillisecond);
+
+void BM_ReadLinesLineBatch(benchmark::State& state) {
+    const std::string& text = linesText();
+    const auto blockSize = static_cast<std::size_t>(state.range(0));
+    for (auto _: state) {
+        std::istringstream in(text);
+        LineBatchReader reader(in, blockSize);
+        LineBatch batch;
+        std::size_t lines = 0;
+        while (reader.next(batch))
+            lines += batch.size();
+        benchmark::DoNotOptimize(lines);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ReadLinesLineBatch)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+} // namespace
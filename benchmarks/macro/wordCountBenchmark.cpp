@@ -0,0 +1,265 @@
+// End-to-end word counting: generated text -> countWordsUsageIgnoringCases() -> words sorted by frequency.
+// With more threads the text is split at word boundaries, every thread counts its part
+// and the partial maps are merged, so the numbers show how the whole pipeline scales.
+// The perf counters of all threads are summed per word: cycles, cache misses and IPC,
+// or the CPU time (task-clock) where the hardware counters are not available.
+//
+// Usage: wordcount_benchmark [--sizes-mb 10,100] [--threads N] [--repetitions R] [--seed S] [--json FILE]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "allocationcounter.h"
+#include "corpusgenerator.h"
+#include "mystring.h"
+#include "perfprobe.h"
+#include "wordtokenizer.h"
+
+namespace {
+
+using WordCounts = std::map<MyString, std::size_t>;
+
+struct Options {
+    std::vector<std::size_t> sizesMb{10, 100};
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned repetitions = 3;
+    std::uint64_t seed = 2024;
+    std::string jsonPath;
+};
+
+struct Result {
+    std::size_t sizeMb;
+    unsigned threads;
+    double seconds;
+    std::size_t allocations;
+    std::size_t allocatedMb;
+    long peakRssMb;
+    std::size_t uniqueWords;
+    std::size_t words;
+    PerfReading counters; ///< of all threads
+};
+
+/// @param counters what the counters of the worker threads counted is added to it
+WordCounts countWords(const MyString& text, unsigned threads, PerfReading& counters) {
+    if (threads <= 1)
+        return text.countWordsUsageIgnoringCases();
+
+    const MyStringView content = text.view();
+    std::vector<std::size_t> bounds{0};
+    for (unsigned part = 1; part < threads; ++part) {
+        std::size_t bound = std::max(content.size() * part / threads, bounds.back());
+        while (bound < content.size() && charclass::letters.contains(content[bound]))
+            ++bound;
+        bounds.push_back(bound);
+    }
+    bounds.push_back(content.size());
+
+    std::vector<WordCounts> partial(threads);
+    std::vector<PerfReading> partialCounters(threads);
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned part = 0; part < threads; ++part)
+            workers.emplace_back([&, part] {
+                const PerfProbe probe(partialCounters[part]);
+                // the words are counted straight from the slice of the text - no copy of the part
+                const MyStringView slice = content.substr(bounds[part], bounds[part + 1] - bounds[part]);
+                forEachWord<charclass::letters>(slice, [&](std::string_view word) {
+                    MyString lowerWord(word);
+                    ++partial[part][lowerWord.toLower()];
+                });
+            });
+    }
+    for (const PerfReading& workerCounters: partialCounters)
+        counters += workerCounters;
+
+    WordCounts result = std::move(partial.front());
+    for (unsigned part = 1; part < threads; ++part) {
+        result.merge(partial[part]); // moves the nodes of new words, only repeated words stay in partial[part]
+        for (const auto& [word, count]: partial[part])
+            result[word] += count;
+    }
+    return result;
+}
+
+std::vector<std::pair<const MyString*, std::size_t>> sortByFrequency(const WordCounts& counts) {
+    std::vector<std::pair<const MyString*, std::size_t>> sorted;
+    sorted.reserve(counts.size());
+    for (const auto& [word, count]: counts)
+        sorted.emplace_back(&word, count);
+    std::ranges::stable_sort(sorted, std::greater{}, &std::pair<const MyString*, std::size_t>::second);
+    return sorted;
+}
+
+/// Resets the peak resident memory of the process (Linux: "5" written to /proc/self/clear_refs resets VmHWM),
+/// so every row reports its own peak - the text of that size and what counting it took.
+/// @return false where it cannot be reset, the row then reports -1
+bool resetPeakRss() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    return static_cast<bool>(clearRefs << "5" << std::flush);
+}
+
+long peakRssMb() {
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);)
+        if (line.starts_with("VmHWM:"))
+            return std::stol(line.substr(line.find_first_not_of(' ', 6))) / 1024; // in kB
+    return -1;
+}
+
+std::vector<std::size_t> parseList(const std::string& text) {
+    std::vector<std::size_t> values;
+    std::istringstream in(text);
+    for (std::string value; std::getline(in, value, ',');)
+        values.push_back(std::stoull(value));
+    return values;
+}
+
+Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string name = argv[i];
+        const std::string value = argv[i + 1];
+        if (name == "--sizes-mb")
+            options.sizesMb = parseList(value);
+        else if (name == "--threads")
+            options.maxThreads = std::max(1u, static_cast<unsigned>(std::stoul(value)));
+        else if (name == "--repetitions")
+            options.repetitions = std::max(1u, static_cast<unsigned>(std::stoul(value)));
+        else if (name == "--seed")
+            options.seed = std::stoull(value);
+        else if (name == "--json")
+            options.jsonPath = value;
+        else
+            std::cerr << "Unknown option ignored: " << name << '\n';
+    }
+    return options;
+}
+
+std::vector<unsigned> threadCounts(unsigned maxThreads) {
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+double perWord(std::uint64_t count, const Result& result) {
+    return static_cast<double>(count) / static_cast<double>(std::max<std::size_t>(result.words, 1));
+}
+
+void writeJson(const std::string& path, const Options& options, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    out << "{\n  \"seed\": " << options.seed << ",\n  \"repetitions\": " << options.repetitions
+        << ",\n  \"perf_hardware_counters\": " << std::boolalpha << PerfCounters::hardwareAvailable()
+        << ",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        out << "    {\"size_mb\": " << result.sizeMb << ", \"threads\": " << result.threads
+            << ", \"seconds\": " << result.seconds << ", \"mb_per_second\": " << result.sizeMb / result.seconds
+            << ", \"allocations\": " << result.allocations << ", \"allocated_mb\": " << result.allocatedMb
+            << ", \"peak_rss_mb\": " << result.peakRssMb << ", \"unique_words\": " << result.uniqueWords
+            << ", \"words\": " << result.words << ", \"task_clock_ns_per_word\": " << perWord(result.counters.taskClockNs, result)
+            << ", \"cycles_per_word\": " << perWord(result.counters.cycles, result)
+            << ", \"cache_misses_per_word\": " << perWord(result.counters.cacheMisses, result)
+            << ", \"branch_misses_per_word\": " << perWord(result.counters.branchMisses, result)
+            << ", \"ipc\": " << result.counters.instructionsPerCycle() << '}'
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    const Options options = parseOptions(argc, argv);
+    std::vector<Result> results;
+
+    std::cout << std::setw(8) << "MB" << std::setw(9) << "threads" << std::setw(11) << "MB/s"
+              << std::setw(9) << "speedup" << std::setw(14) << "allocations" << std::setw(14) << "allocated MB"
+              << std::setw(13) << "peak RSS MB" << std::setw(11) << "words" << std::setw(14) << "unique words";
+    const bool hardwareCounters = PerfCounters::hardwareAvailable();
+    if (hardwareCounters)
+        std::cout << std::setw(13) << "cycles/word" << std::setw(18) << "cache-misses/word" << std::setw(6) << "IPC";
+    else
+        std::cout << std::setw(14) << "task-ns/word";
+    std::cout << '\n';
+
+    for (const std::size_t sizeMb: options.sizesMb) {
+        CorpusOptions corpusOptions;
+        corpusOptions.seed = options.seed;
+        const MyString text = CorpusGenerator(corpusOptions).generate(sizeMb << 20);
+
+        double singleThreadSeconds = 0;
+        WordCounts expectedCounts; // of the 1-thread run, every merged result has to be equal to it
+        for (const unsigned threads: threadCounts(options.maxThreads)) {
+            Result best{sizeMb, threads, 1e300, 0, 0, 0, 0, 0, {}};
+            const bool peakRssReset = resetPeakRss();
+            for (unsigned repetition = 0; repetition < options.repetitions; ++repetition) {
+                const allocations::Scope allocationScope;
+                PerfReading counters;
+                const auto start = std::chrono::steady_clock::now();
+
+                WordCounts counts;
+                std::vector<std::pair<const MyString*, std::size_t>> sorted;
+                {
+                    const PerfProbe probe(counters); // the main thread: merging and sorting, or all the work
+                    counts = countWords(text, threads, counters);
+                    sorted = sortByFrequency(counts);
+                }
+
+                const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                if (elapsed.count() < best.seconds) {
+                    best.seconds = elapsed.count();
+                    best.allocations = allocationScope.heap().allocations;
+                    best.allocatedMb = allocationScope.heap().bytes >> 20;
+                    best.uniqueWords = sorted.size();
+                    best.words = 0;
+                    for (const auto& [word, count]: sorted)
+                        best.words += count;
+                    best.counters = counters;
+                }
+
+                if (threads == 1 && repetition == 0) {
+                    expectedCounts = std::move(counts);
+                } else if (counts != expectedCounts) {
+                    std::cerr << "Different word counts with " << threads << " threads!\n";
+                    return EXIT_FAILURE;
+                }
+            }
+            best.peakRssMb = peakRssReset ? peakRssMb() : -1;
+
+            if (threads == 1)
+                singleThreadSeconds = best.seconds;
+            std::cout << std::fixed << std::setprecision(1)
+                      << std::setw(8) << sizeMb << std::setw(9) << threads << std::setw(11) << sizeMb / best.seconds
+                      << std::setw(9) << std::setprecision(2) << singleThreadSeconds / best.seconds
+                      << std::setw(14) << best.allocations << std::setw(14) << best.allocatedMb
+                      << std::setw(13) << best.peakRssMb << std::setw(11) << best.words
+                      << std::setw(14) << best.uniqueWords;
+            if (hardwareCounters)
+                std::cout << std::setw(13) << perWord(best.counters.cycles, best)
+                          << std::setw(18) << std::setprecision(3) << perWord(best.counters.cacheMisses, best)
+                          << std::setw(6) << std::setprecision(2) << best.counters.instructionsPerCycle();
+            else
+                std::cout << std::setw(14) << perWord(best.counters.taskClockNs, best);
+            std::cout << std::endl;
+            results.push_back(best);
+        }
+    }
+
+    if (!options.jsonPath.empty())
+        writeJson(options.jsonPath, options, results);
+    return EXIT_SUCCESS;
+}
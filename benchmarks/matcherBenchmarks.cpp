@@ -0,0 +1,41 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "corpusgenerator.h"
+#include "mystring.h"
+#include "mystringmatcher.h"
+
+namespace {
+
+std::vector<MyString> makeKeywords(std::size_t count) {
+    std::vector<MyString> keywords;
+    keywords.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        keywords.push_back(MyString::generateRandomWord(4 + i % 9));
+    return keywords;
+}
+
+void BM_MyStringMatcherScan(benchmark::State& state) {
+    const MyStringMatcher matcher(makeKeywords(state.range(0)), true);
+    const MyString text = CorpusGenerator().generate(2 << 20);
+
+    std::size_t matches = 0;
+    for (auto _: state)
+        matcher.scan(text, [&](const MyStringMatcher::Match&) { ++matches; });
+    benchmark::DoNotOptimize(matches);
+    state.counters["matches/MB"] = static_cast<double>(matches) / state.iterations() / (text.size() / 1e6);
+    state.counters["states"] = static_cast<double>(matcher.stateCount());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_MyStringMatcherScan)->Arg(1'000)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+void BM_MyStringMatcherBuild(benchmark::State& state) {
+    const std::vector<MyString> keywords = makeKeywords(state.range(0));
+    for (auto _: state)
+        benchmark::DoNotOptimize(MyStringMatcher(keywords));
+}
+BENCHMARK(BM_MyStringMatcherBuild)->Arg(1'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+} // namespace
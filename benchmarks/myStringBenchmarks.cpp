@@ -0,0 +1,382 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "corpusgenerator.h"
+#include "fixedmystring.h"
+#include "mystring.h"
+#include "mystringbuilder.h"
+#include "packedword.h"
+#include "wordtokenizer.h"
+
+// Every benchmark is instantiated for MyString and std::string, so both are reported side by side.
+// Sizes are chosen around the 20-character inline buffer of MyString (and 15 of libstdc++ std::string).
+namespace {
+
+void inlineBoundarySizes(benchmark::internal::Benchmark* benchmark) {
+    for (const int length: {8, 15, 16, 19, 20, 21, 32, 64, 256})
+        benchmark->Arg(length);
+}
+
+std::string makeText(std::size_t length) {
+    std::string text(length, '\0');
+    for (std::size_t i = 0; i < length; ++i)
+        text[i] = static_cast<char>('a' + (i * 7) % 26);
+    return text;
+}
+
+template<typename String>
+String makeString(std::size_t length) {
+    return String(std::string_view(makeText(length)));
+}
+
+template<typename String>
+void BM_ConstructFromCString(benchmark::State& state) {
+    const std::string source = makeText(state.range(0));
+    for (auto _: state) {
+        String text(source.c_str());
+        benchmark::DoNotOptimize(text);
+    }
+}
+BENCHMARK_TEMPLATE(BM_ConstructFromCString, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_ConstructFromCString, std::string)->Apply(inlineBoundarySizes);
+
+template<typename String>
+void BM_Copy(benchmark::State& state) {
+    const String source = makeString<String>(state.range(0));
+    for (auto _: state) {
+        String copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK_TEMPLATE(BM_Copy, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_Copy, std::string)->Apply(inlineBoundarySizes);
+
+template<typename String>
+void BM_MoveBackAndForth(benchmark::State& state) {
+    String first = makeString<String>(state.range(0));
+    for (auto _: state) {
+        String second(std::move(first));
+        benchmark::DoNotOptimize(second);
+        first = std::move(second);
+    }
+}
+BENCHMARK_TEMPLATE(BM_MoveBackAndForth, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_MoveBackAndForth, std::string)->Apply(inlineBoundarySizes);
+
+/// Builds a string of the given length from 4-character pieces, starting empty.
+template<typename String>
+void BM_AppendPieces(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    constexpr std::string_view piece = "abcd";
+    for (auto _: state) {
+        String text;
+        for (std::size_t size = 0; size < length; size += piece.size())
+            text.append(piece);
+        benchmark::DoNotOptimize(text);
+    }
+}
+BENCHMARK_TEMPLATE(BM_AppendPieces, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_AppendPieces, std::string)->Apply(inlineBoundarySizes);
+
+template<typename String>
+void BM_IndexAll(benchmark::State& state) {
+    const String text = makeString<String>(state.range(0));
+    for (auto _: state) {
+        unsigned sum = 0;
+        for (std::size_t i = 0; i < text.size(); ++i)
+            sum += static_cast<unsigned char>(text[i]);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK_TEMPLATE(BM_IndexAll, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_IndexAll, std::string)->Apply(inlineBoundarySizes);
+
+template<typename String>
+void BM_Iterate(benchmark::State& state) {
+    const String text = makeString<String>(state.range(0));
+    for (auto _: state) {
+        unsigned sum = 0;
+        for (const char ch: text)
+            sum += static_cast<unsigned char>(ch);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK_TEMPLATE(BM_Iterate, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_Iterate, std::string)->Apply(inlineBoundarySizes);
+
+/// Equal contents - the worst case, every character is compared.
+template<typename String>
+void BM_CompareEqual(benchmark::State& state) {
+    const String first = makeString<String>(state.range(0));
+    const String second = makeString<String>(state.range(0));
+    for (auto _: state)
+        benchmark::DoNotOptimize(first < second);
+}
+BENCHMARK_TEMPLATE(BM_CompareEqual, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_CompareEqual, std::string)->Apply(inlineBoundarySizes);
+
+template<typename String>
+void BM_Hash(benchmark::State& state) {
+    const String text = makeString<String>(state.range(0));
+    for (auto _: state)
+        benchmark::DoNotOptimize(std::hash<String>{}(text));
+}
+BENCHMARK_TEMPLATE(BM_Hash, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_Hash, std::string)->Apply(inlineBoundarySizes);
+
+void trimInPlace(std::string& text) {
+    text.erase(text.find_last_not_of(" \t\n\v\f\r") + 1);
+    text.erase(0, text.find_first_not_of(" \t\n\v\f\r"));
+}
+
+void trimInPlace(MyString& text) {
+    text.trim();
+}
+
+/// Includes the copy of the padded source, which is needed to trim it again in every iteration.
+template<typename String>
+void BM_CopyAndTrim(benchmark::State& state) {
+    const String padded(std::string_view("  \t " + makeText(state.range(0)) + " \n  "));
+    for (auto _: state) {
+        String text(padded);
+        trimInPlace(text);
+        benchmark::DoNotOptimize(text);
+    }
+}
+BENCHMARK_TEMPLATE(BM_CopyAndTrim, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_CopyAndTrim, std::string)->Apply(inlineBoundarySizes);
+
+void toLowerInPlace(std::string& text) {
+    std::ranges::transform(text, text.begin(), [](char ch) {
+        return ('A' <= ch && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+    });
+}
+
+void toLowerInPlace(MyString& text) {
+    text.toLower();
+}
+
+/// Includes the copy of the source, like BM_CopyAndTrim.
+template<typename String>
+void BM_CopyAndToLower(benchmark::State& state) {
+    std::string mixedCase = makeText(state.range(0));
+    for (std::size_t i = 0; i < mixedCase.size(); i += 2)
+        mixedCase[i] = static_cast<char>(mixedCase[i] - 'a' + 'A');
+    const String source(std::string_view{mixedCase});
+    for (auto _: state) {
+        String text(source);
+        toLowerInPlace(text);
+        benchmark::DoNotOptimize(text);
+    }
+}
+BENCHMARK_TEMPLATE(BM_CopyAndToLower, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_CopyAndToLower, std::string)->Apply(inlineBoundarySizes);
+
+std::string joinPieces(const std::vector<std::string>& pieces, std::string_view separator) {
+    std::size_t length = pieces.empty() ? 0 : separator.size() * (pieces.size() - 1);
+    for (const auto& piece: pieces)
+        length += piece.size();
+    std::string result;
+    result.reserve(length);
+    for (std::size_t i = 0; i < pieces.size(); ++i) {
+        if (i > 0)
+            result.append(separator);
+        result.append(pieces[i]);
+    }
+    return result;
+}
+
+MyString joinPieces(const std::vector<MyString>& pieces, std::string_view separator) {
+    return MyString(separator).join(pieces);
+}
+
+/// 64 pieces of the given length.
+template<typename String>
+void BM_Join(benchmark::State& state) {
+    const std::vector<String> pieces(64, makeString<String>(state.range(0)));
+    for (auto _: state)
+        benchmark::DoNotOptimize(joinPieces(pieces, ", "));
+}
+BENCHMARK_TEMPLATE(BM_Join, MyString)->Apply(inlineBoundarySizes);
+BENCHMARK_TEMPLATE(BM_Join, std::string)->Apply(inlineBoundarySizes);
+
+std::map<std::string, std::size_t> countWordsUsageIgnoringCases(const std::string& text) {
+    std::map<std::string, std::size_t> usage;
+    forEachWord<charclass::letters>(std::string_view(text), [&](std::string_view word) {
+        std::string key(word);
+        toLowerInPlace(key);
+        ++usage[key];
+    });
+    return usage;
+}
+
+std::map<MyString, std::size_t> countWordsUsageIgnoringCases(const MyString& text) {
+    return text.countWordsUsageIgnoringCases();
+}
+
+/// Word counting on a generated text of the given length.
+template<typename String>
+void BM_CountWordsUsageIgnoringCases(benchmark::State& state) {
+    const MyString corpus = CorpusGenerator().generate(state.range(0));
+    const std::string content = corpus.toString();
+    const String text{std::string_view(content)};
+    for (auto _: state)
+        benchmark::DoNotOptimize(countWordsUsageIgnoringCases(text));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK_TEMPLATE(BM_CountWordsUsageIgnoringCases, MyString)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_CountWordsUsageIgnoringCases, std::string)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+
+/// The same with PackedWord keys: no allocation for words up to 32 letters, comparisons of packed numbers.
+void BM_CountWordsUsageIgnoringCasesPacked(benchmark::State& state) {
+    const MyString text = CorpusGenerator().generate(state.range(0));
+    for (auto _: state)
+        benchmark::DoNotOptimize(packedwords::countWordsUsageIgnoringCases(text));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_CountWordsUsageIgnoringCasesPacked)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+
+/// Unique words of 21-32 letters: heap parts of MyString keys against packed keys.
+template<typename Word>
+void BM_UniqueLongWords(benchmark::State& state) {
+    std::vector<std::string> words;
+    for (std::size_t i = 0; i < 4096; ++i) {
+        std::string word = makeText(21 + i % 12);
+        word[i % word.size()] = static_cast<char>('a' + i % 26);
+        word[(i / 26) % word.size()] = static_cast<char>('a' + (i / 26) % 26);
+        words.push_back(std::move(word));
+    }
+    for (auto _: state) {
+        std::set<Word> unique;
+        for (const std::string& word: words)
+            unique.emplace(std::string_view(word));
+        benchmark::DoNotOptimize(unique.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+}
+BENCHMARK_TEMPLATE(BM_UniqueLongWords, MyString);
+BENCHMARK_TEMPLATE(BM_UniqueLongWords, PackedWord);
+
+/// "word count" lines of a word count report: std::to_string + conversion against appendNumber().
+void BM_ReportCountsToString(benchmark::State& state) {
+    const auto usage = CorpusGenerator().generate(1 << 20).countWordsUsageIgnoringCases();
+    for (auto _: state) {
+        MyString report;
+        for (const auto& [word, count]: usage) {
+            report += word;
+            report += ' ';
+            report += MyString(std::to_string(count).c_str());
+            report += '\n';
+        }
+        benchmark::DoNotOptimize(report);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * usage.size()));
+}
+BENCHMARK(BM_ReportCountsToString)->Unit(benchmark::kMillisecond);
+
+void BM_ReportCountsAppendNumber(benchmark::State& state) {
+    const auto usage = CorpusGenerator().generate(1 << 20).countWordsUsageIgnoringCases();
+    for (auto _: state) {
+        MyString report;
+        for (const auto& [word, count]: usage) {
+            report += word;
+            report += ' ';
+            report.appendNumber(count);
+            report += '\n';
+        }
+        benchmark::DoNotOptimize(report);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * usage.size()));
+}
+BENCHMARK(BM_ReportCountsAppendNumber)->Unit(benchmark::kMillisecond);
+
+void BM_ParseNumber(benchmark::State& state) {
+    std::vector<MyString> numbers;
+    for (std::uint32_t i = 0; i < 10'000; ++i)
+        numbers.emplace_back().appendNumber(i * 2654435761u);
+    for (auto _: state) {
+        std::uint64_t sum = 0;
+        for (const MyString& number: numbers)
+            sum += number.parseNumber<std::uint32_t>().value_or(0);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numbers.size()));
+}
+BENCHMARK(BM_ParseNumber);
+
+/// Text built character by character: MyString::operator+=(char) against MyStringBuilder (reused between iterations).
+void BM_BuildCharByCharMyString(benchmark::State& state) {
+    const std::string source = CorpusGenerator().generate(static_cast<std::size_t>(state.range(0))).toString();
+    for (auto _: state) {
+        MyString text;
+        for (const char ch: source)
+            text += ch;
+        benchmark::DoNotOptimize(text);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+}
+BENCHMARK(BM_BuildCharByCharMyString)->Arg(1 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+void BM_BuildCharByCharBuilder(benchmark::State& state) {
+    const std::string source = CorpusGenerator().generate(static_cast<std::size_t>(state.range(0))).toString();
+    MyStringBuilder builder;
+    for (auto _: state) {
+        builder.reset();
+        for (const char ch: source)
+            builder += ch;
+        benchmark::DoNotOptimize(builder.build());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+}
+BENCHMARK(BM_BuildCharByCharBuilder)->Arg(1 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+/// prefix + key + ":" + value: repeated += against one lazily evaluated expression.
+void BM_ConcatenateWithPlusEqual(benchmark::State& state) {
+    const MyString prefix("service/region/"), key(makeText(static_cast<std::size_t>(state.range(0))).c_str());
+    const MyString value("some value");
+    for (auto _: state) {
+        MyString result(prefix);
+        result += key;
+        result += MyString(":");
+        result += value;
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_ConcatenateWithPlusEqual)->Arg(8)->Arg(64)->Arg(256);
+
+void BM_ConcatenateWithExpression(benchmark::State& state) {
+    const MyString prefix("service/region/"), key(makeText(static_cast<std::size_t>(state.range(0))).c_str());
+    const MyString value("some value");
+    for (auto _: state) {
+        MyString result = prefix + key + ":" + value;
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_ConcatenateWithExpression)->Arg(8)->Arg(64)->Arg(256);
+
+/// Copying a batch of 21-32 character words: past the inline buffer of MyString, within FixedMyString<32>.
+template<typename String>
+void BM_CopyLongWords(benchmark::State& state) {
+    std::vector<String> words;
+    for (std::size_t i = 0; i < 1024; ++i)
+        words.emplace_back(makeText(21 + i % 12).c_str());
+    for (auto _: state) {
+        std::vector<String> copy(words);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+}
+BENCHMARK_TEMPLATE(BM_CopyLongWords, MyString);
+BENCHMARK_TEMPLATE(BM_CopyLongWords, FixedMyString<32>);
+
+} // namespace
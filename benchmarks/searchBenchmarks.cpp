@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "mystring.h"
+
+namespace {
+
+constexpr std::string_view filler = "lorem ipsum dolor sit amet, consectetur adipiscing elit ";
+
+/// Text of the given size without the searched pattern, which is appended at its end.
+std::string makeHaystack(std::size_t length, std::string_view pattern) {
+    std::string haystack;
+    while (haystack.size() + pattern.size() < length)
+        haystack.append(filler.substr(0, std::min(filler.size(), length - pattern.size() - haystack.size())));
+    haystack.append(pattern);
+    return haystack;
+}
+
+/// Pattern looking like the text, so that its first bytes are frequent, but differing on the last byte.
+std::string makePattern(std::size_t length) {
+    std::string pattern;
+    while (pattern.size() < length)
+        pattern.append(filler.substr(0, length - pattern.size()));
+    pattern.back() = '#';
+    return pattern;
+}
+
+void searchArguments(benchmark::internal::Benchmark* benchmark) {
+    for (const int textLength : {1 << 10, 1 << 16, 1 << 20})
+        for (const int patternLength : {1, 4, 12, 32, 256})
+            benchmark->Args({textLength, patternLength});
+}
+
+void BM_MyStringFind(benchmark::State& state) {
+    const std::string pattern = makePattern(state.range(1));
+    const MyString text(makeHaystack(state.range(0), pattern).c_str());
+    for (auto _: state)
+        benchmark::DoNotOptimize(text.find(pattern));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MyStringFind)->Apply(searchArguments);
+
+void BM_StdStringFind(benchmark::State& state) {
+    const std::string pattern = makePattern(state.range(1));
+    const std::string text = makeHaystack(state.range(0), pattern);
+    for (auto _: state)
+        benchmark::DoNotOptimize(text.find(pattern));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StdStringFind)->Apply(searchArguments);
+
+void BM_StdSearch(benchmark::State& state) {
+    const std::string pattern = makePattern(state.range(1));
+    const std::string text = makeHaystack(state.range(0), pattern);
+    for (auto _: state)
+        benchmark::DoNotOptimize(std::search(text.begin(), text.end(), pattern.begin(), pattern.end()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StdSearch)->Apply(searchArguments);
+
+} // namespace
@@ -0,0 +1,58 @@
+#include <fcntl.h>
+#include <fstream>
+#include <unistd.h>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "mystring.h"
+#include "mystringwriter.h"
+
+namespace {
+
+/// Records of 1-40 characters, so both inline and heap strings are written.
+const std::vector<MyString>& records() {
+    static const std::vector<MyString> strings = [] {
+        std::vector<MyString> result;
+        MyString::seedRandomWords(42);
+        for (std::size_t i = 0; i < 1'000'000; ++i)
+            result.push_back(MyString::generateRandomWord(1 + i % 40));
+        return result;
+    }();
+    return strings;
+}
+
+std::size_t totalBytes(const std::vector<MyString>& strings) {
+    std::size_t bytes = 0;
+    for (const MyString& text: strings)
+        bytes += text.size() + 1;
+    return bytes;
+}
+
+void BM_WriteRecordsOstream(benchmark::State& state) {
+    const std::vector<MyString>& strings = records();
+    std::ofstream out("/dev/null");
+    for (auto _: state) {
+        for (const MyString& text: strings)
+            out << text << '\n';
+        out.flush();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * strings.size()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * totalBytes(strings)));
+}
+BENCHMARK(BM_WriteRecordsOstream)->Unit(benchmark::kMillisecond);
+
+void BM_WriteRecordsWritev(benchmark::State& state) {
+    const std::vector<MyString>& strings = records();
+    const int fd = ::open("/dev/null", O_WRONLY);
+    MyStringWriter writer(fd);
+    for (auto _: state)
+        writer.writeAll(strings);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * strings.size()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * totalBytes(strings)));
+    state.counters["syscalls/iteration"] = static_cast<double>(writer.systemCalls()) / static_cast<double>(state.iterations());
+    ::close(fd);
+}
+BENCHMARK(BM_WriteRecordsWritev)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,162 @@
+#include "corpusgenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <ostream>
+#include <string_view>
+#include <unordered_set>
+
+namespace {
+
+std::uint32_t probabilityThreshold(double probability) {
+    return static_cast<std::uint32_t>(std::clamp(probability, 0.0, 1.0) * 4294967295.0);
+}
+
+/// 1 + Poisson(mean - 1) for lengths min..max, the probability of shorter and longer words added to the ends.
+std::vector<double> wordLengthWeights(const CorpusOptions& options) {
+    const double lambda = std::max(options.meanWordLength - 1.0, 0.0);
+    std::vector<double> weights(options.maxWordLength - options.minWordLength + 1);
+    double probability = std::exp(-lambda); // of length 1
+    double below = 0;
+    for (std::size_t length = 1; length < options.maxWordLength; ++length) {
+        if (length <= options.minWordLength)
+            below += probability;
+        else
+            weights[length - options.minWordLength] = probability;
+        probability *= lambda / static_cast<double>(length);
+    }
+    weights.back() = std::max(1.0 - below - std::accumulate(weights.begin(), weights.end(), 0.0), 0.0);
+    weights.front() += below;
+    return weights;
+}
+
+std::vector<double> zipfWeights(std::size_t size, double exponent) {
+    std::vector<double> weights(size);
+    for (std::size_t rank = 0; rank < size; ++rank)
+        weights[rank] = 1.0 / std::pow(static_cast<double>(rank + 1), exponent);
+    return weights;
+}
+
+} // namespace
+
+
+CorpusGenerator::CorpusGenerator(const CorpusOptions& options)
+        : options_(options), random_(options.seed),
+          punctuationThreshold_(probabilityThreshold(options.punctuationProbability)),
+          newlineThreshold_(probabilityThreshold(options.newlineProbability)),
+          capitalizedThreshold_(probabilityThreshold(options.capitalizedProbability)),
+          upperCaseThreshold_(probabilityThreshold(options.upperCaseProbability)) {
+    options_.vocabularySize = std::max<std::size_t>(options_.vocabularySize, 1);
+    options_.minWordLength = std::max<std::size_t>(options_.minWordLength, 1);
+    options_.maxWordLength = std::max(options_.maxWordLength, options_.minWordLength);
+    wordLengths_.build(wordLengthWeights(options_));
+    buildVocabulary();
+    ranks_.build(zipfWeights(vocabulary_.size(), options_.zipfExponent));
+}
+
+void CorpusGenerator::buildVocabulary() {
+    std::unordered_set<std::string> used;
+    vocabulary_.reserve(options_.vocabularySize);
+
+    std::size_t failures = 0;
+    while (vocabulary_.size() < options_.vocabularySize) {
+        const std::size_t length = options_.minWordLength + wordLengths_.sample(random_())
+                                   + failures / 64; // all short words are taken - make them longer
+        std::string word(length, '\0');
+        random_.fillLowercaseLetters(word.data(), length);
+        if (used.insert(word).second) {
+            vocabulary_.push_back(std::move(word));
+            failures = 0;
+        } else {
+            ++failures;
+        }
+    }
+}
+
+void CorpusGenerator::AliasTable::build(std::vector<double> weights) {
+    const std::size_t size = weights.size();
+    const double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    for (auto& weight: weights)
+        weight *= static_cast<double>(size) / sum;
+
+    threshold.assign(size, UINT32_MAX);
+    alias.resize(size);
+    for (std::uint32_t i = 0; i < size; ++i)
+        alias[i] = i;
+
+    std::vector<std::uint32_t> small, large;
+    for (std::uint32_t i = 0; i < size; ++i)
+        (weights[i] < 1.0 ? small : large).push_back(i);
+    while (!small.empty() && !large.empty()) {
+        const std::uint32_t less = small.back();
+        const std::uint32_t more = large.back();
+        small.pop_back();
+        threshold[less] = probabilityThreshold(weights[less]);
+        alias[less] = more;
+        weights[more] -= 1.0 - weights[less];
+        if (weights[more] < 1.0) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+}
+
+std::size_t CorpusGenerator::AliasTable::sample(std::uint64_t bits) const {
+    const auto column = static_cast<std::size_t>(((bits >> 32) * threshold.size()) >> 32);
+    return static_cast<std::uint32_t>(bits) <= threshold[column] ? column : alias[column];
+}
+
+std::size_t CorpusGenerator::sampleRank() {
+    return ranks_.sample(random_());
+}
+
+void CorpusGenerator::fillBlock(std::string& block, std::size_t targetLength) {
+    constexpr std::string_view punctuation = ",.;:!?";
+    while (block.size() < targetLength) {
+        const std::string& word = vocabulary_[sampleRank()];
+        const std::uint64_t caseAndPunctuation = random_();
+        const std::uint64_t separator = random_();
+
+        const std::size_t wordBegin = block.size();
+        block.append(word);
+        const auto caseDraw = static_cast<std::uint32_t>(caseAndPunctuation);
+        if (caseDraw < upperCaseThreshold_)
+            std::transform(block.begin() + static_cast<std::ptrdiff_t>(wordBegin), block.end(),
+                           block.begin() + static_cast<std::ptrdiff_t>(wordBegin),
+                           [](char ch) { return static_cast<char>(ch - 'a' + 'A'); });
+        else if (caseDraw - upperCaseThreshold_ < capitalizedThreshold_)
+            block[wordBegin] = static_cast<char>(block[wordBegin] - 'a' + 'A');
+
+        if (static_cast<std::uint32_t>(caseAndPunctuation >> 32) < punctuationThreshold_)
+            block += punctuation[(separator >> 32) % punctuation.size()];
+        block += static_cast<std::uint32_t>(separator) < newlineThreshold_ ? '\n' : ' ';
+    }
+}
+
+MyString CorpusGenerator::generate(std::size_t length) {
+    MyString text;
+    text.reserve(length);
+
+    std::string block;
+    block.reserve(blockSize_ + 256);
+    while (text.size() < length) {
+        block.swap(pending_);
+        pending_.clear();
+        fillBlock(block, std::min(blockSize_, length - text.size()));
+
+        const std::size_t taken = std::min(block.size(), length - text.size());
+        text.append(std::string_view(block).substr(0, taken));
+        pending_.assign(block, taken);
+        block.clear();
+    }
+    return text;
+}
+
+void CorpusGenerator::generate(std::ostream& out, std::size_t length) {
+    while (length > 0) {
+        const MyString block = generate(std::min(length, blockSize_));
+        out << block;
+        length -= block.size();
+    }
+}
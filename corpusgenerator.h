@@ -0,0 +1,75 @@
+#ifndef CORPUSGENERATOR_H
+#define CORPUSGENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "fastrandom.h"
+#include "mystring.h"
+
+
+struct CorpusOptions {
+    std::size_t vocabularySize = 10'000;
+    double zipfExponent = 1.0;            ///< frequency of the word with rank r is proportional to 1 / r^zipfExponent
+    std::size_t minWordLength = 1;
+    std::size_t maxWordLength = 20;
+    double meanWordLength = 5.0;          ///< lengths: 1 + Poisson(mean - 1), clamped to [min, max]
+    double punctuationProbability = 0.08; ///< one of ",.;:!?" right after a word
+    double newlineProbability = 0.02;     ///< '\n' instead of ' ' after a word
+    double capitalizedProbability = 0.10; ///< "Word"
+    double upperCaseProbability = 0.01;   ///< "WORD"
+    std::uint64_t seed = 2024;
+};
+
+/// Deterministic (for the given options) generator of text resembling natural language:
+/// a random vocabulary sampled with Zipf distribution (alias method - O(1) per word),
+/// with punctuation, line breaks and mixed letter case. Text is produced in blocks into one buffer.
+/// Every random choice is made from FastRandom by the generator itself (no <random> distributions),
+/// so a seed gives the same text with every standard library.
+class CorpusGenerator {
+public:
+    explicit CorpusGenerator(const CorpusOptions& options = {});
+
+    /// @return text of exactly length characters (the last word may be cut)
+    [[nodiscard]] MyString generate(std::size_t length);
+    void generate(std::ostream& out, std::size_t length);
+
+    /// Words ordered by rank - vocabulary()[0] is the most frequent one.
+    [[nodiscard]] const std::vector<std::string>& vocabulary() const { return vocabulary_; }
+
+private:
+    static constexpr std::size_t blockSize_ = 1 << 16;
+
+    /// Walker's alias method: column i is chosen uniformly, then either i or alias[i] is returned.
+    struct AliasTable {
+        std::vector<std::uint32_t> threshold;
+        std::vector<std::uint32_t> alias;
+
+        /// weights do not have to be normalized
+        void build(std::vector<double> weights);
+        /// High 32 bits choose the column, low 32 bits choose between it and its alias.
+        [[nodiscard]] std::size_t sample(std::uint64_t bits) const;
+    };
+
+    CorpusOptions options_;
+    FastRandom random_;
+    std::vector<std::string> vocabulary_;
+    AliasTable ranks_;
+    AliasTable wordLengths_; ///< index 0 is minWordLength
+    std::uint32_t punctuationThreshold_;
+    std::uint32_t newlineThreshold_;
+    std::uint32_t capitalizedThreshold_;
+    std::uint32_t upperCaseThreshold_;
+    std::string pending_; ///< generated, but not yet returned, end of the last word
+
+    void buildVocabulary();
+    std::size_t sampleRank();
+    /// Appends whole words to block until it reaches at least targetLength.
+    void fillBlock(std::string& block, std::size_t targetLength);
+};
+
+
+#endif //CORPUSGENERATOR_H
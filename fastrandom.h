@@ -0,0 +1,62 @@
+#ifndef FASTRANDOM_H
+#define FASTRANDOM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/// xoshiro256** (https://prng.di.unimi.it/) - small, fast, statistically good generator,
+/// seeded with splitmix64 as recommended by its authors. Satisfies UniformRandomBitGenerator.
+/// Not thread-safe: every thread should own its instance.
+class FastRandom {
+public:
+    using result_type = std::uint64_t;
+
+    explicit FastRandom(std::uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(std::uint64_t seed) {
+        for (auto& word: state_) {
+            seed += 0x9E3779B97F4A7C15ull;
+            std::uint64_t mixed = seed;
+            mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+            word = mixed ^ (mixed >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const std::uint64_t shifted = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= shifted;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    /// Fills [destination, destination + length) with 'a'-'z', 4 letters per generator call:
+    /// every 16 bits of a draw are mapped to [0, 26) with a multiply-shift instead of a division.
+    void fillLowercaseLetters(char* destination, std::size_t length) {
+        constexpr unsigned alphabetSize = 26;
+        while (length > 0) {
+            std::uint64_t bits = (*this)();
+            for (int i = 0; i < 4 && length > 0; ++i, --length, bits >>= 16)
+                *destination++ = static_cast<char>('a' + (((bits & 0xFFFF) * alphabetSize) >> 16));
+        }
+    }
+
+private:
+    std::array<std::uint64_t, 4> state_{};
+
+    static constexpr std::uint64_t rotl(std::uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+};
+
+#endif //FASTRANDOM_H
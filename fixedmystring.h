@@ -0,0 +1,292 @@
+#ifndef FIXEDMYSTRING_H
+#define FIXEDMYSTRING_H
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "asciikernels.h"
+#include "mystring.h"
+#include "wordtokenizer.h"
+
+
+/// What FixedMyString does with text that does not fit its capacity.
+enum class OverflowPolicy {
+    truncate,  ///< keeps the part that fits and sets error()
+    errorCode, ///< leaves the string unchanged and sets error()
+    terminate  ///< calls std::terminate()
+};
+
+/// String of at most N characters kept entirely inline: it never allocates and is trivially copyable,
+/// so it suits hot loops and real-time threads. The API follows MyString; the text is contiguous,
+/// so it also converts implicitly to std::string_view. After an overflow error() returns
+/// std::errc::value_too_large until clear() or an assignment.
+template<std::size_t N, OverflowPolicy Policy = OverflowPolicy::truncate>
+class FixedMyString {
+    static_assert(N >= 1 && N <= std::numeric_limits<std::uint32_t>::max(), "FixedMyString capacity out of range");
+
+    /// The smallest type holding N, so FixedMyString<15> takes 16 bytes.
+    using SizeType = std::conditional_t<N <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+                     std::conditional_t<N <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t, std::uint32_t>>;
+
+    std::array<char, N> text_{};
+    SizeType size_{};
+    bool overflowed_{};
+
+    static constexpr bool isWhitespace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\v' || ch == '\f' || ch == '\r';
+    }
+
+    /// Formatted into a stack buffer first, so a number that does not fit follows the Policy like any text.
+    template<std::size_t MaxLength, typename ToChars>
+    FixedMyString& appendChars(ToChars toChars) {
+        return append(mystring_chars::Buffer<MaxLength>(toChars).view());
+    }
+
+public:
+    using value_type = char;
+    using size_type = std::size_t;
+    using iterator = char*;
+    using const_iterator = const char*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr std::size_t npos = std::string_view::npos;
+
+    constexpr FixedMyString() = default;
+    constexpr FixedMyString(const char* text) : FixedMyString(std::string_view(text)) {}
+    constexpr explicit FixedMyString(std::string_view text) { append(text); }
+    constexpr explicit FixedMyString(const MyStringView& text) { append(text); }
+    /// Copies both parts of the MyString; the conversion back is toMyString() or MyString(fixed).
+    constexpr explicit FixedMyString(const MyString& text) : FixedMyString(text.view()) {}
+
+    [[nodiscard]] MyString toMyString() const { return MyString(view()); }
+
+    constexpr iterator begin() { return text_.data(); }
+    constexpr iterator end() { return text_.data() + size_; }
+    constexpr const_iterator begin() const { return text_.data(); }
+    constexpr const_iterator end() const { return text_.data() + size_; }
+    constexpr const_iterator cbegin() const { return begin(); }
+    constexpr const_iterator cend() const { return end(); }
+    constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
+    constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    constexpr const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    constexpr const_reverse_iterator crbegin() const { return rbegin(); }
+    constexpr const_reverse_iterator crend() const { return rend(); }
+
+    [[nodiscard]] constexpr std::size_t size() const { return size_; }
+    [[nodiscard]] static constexpr std::size_t capacity() { return N; }
+    [[nodiscard]] constexpr bool empty() const { return size_ == 0; }
+    [[nodiscard]] constexpr bool full() const { return size_ == N; }
+    [[nodiscard]] constexpr const char* data() const { return text_.data(); }
+    [[nodiscard]] constexpr std::string_view view() const { return {text_.data(), size_}; }
+    constexpr operator std::string_view() const { return view(); }
+
+    /// std::errc::value_too_large when some text did not fit (OverflowPolicy::truncate or errorCode).
+    [[nodiscard]] constexpr std::errc error() const {
+        return overflowed_ ? std::errc::value_too_large : std::errc();
+    }
+
+    constexpr void clear() {
+        size_ = 0;
+        overflowed_ = false;
+    }
+
+    constexpr char& operator[](std::size_t index) {
+        if (index >= size_)
+            throw std::out_of_range("FixedMyString::operator[]: invalid index");
+        return text_[index];
+    }
+    constexpr const char& operator[](std::size_t index) const {
+        if (index >= size_)
+            throw std::out_of_range("FixedMyString::operator[]: invalid index");
+        return text_[index];
+    }
+
+    constexpr FixedMyString& append(std::string_view text) {
+        std::size_t count = text.size();
+        if (count > N - size_) {
+            if constexpr (Policy == OverflowPolicy::terminate)
+                std::terminate();
+            overflowed_ = true;
+            if constexpr (Policy == OverflowPolicy::errorCode)
+                return *this;
+            count = N - size_;
+        }
+        std::copy_n(text.data(), count, text_.data() + size_);
+        size_ = static_cast<SizeType>(size_ + count);
+        return *this;
+    }
+    /// With OverflowPolicy::errorCode the parts are all-or-nothing together, not one by one.
+    constexpr FixedMyString& append(const MyStringView& text) {
+        if constexpr (Policy == OverflowPolicy::errorCode) {
+            if (text.size() > N - size_) {
+                overflowed_ = true;
+                return *this;
+            }
+        }
+        return append(text.head).append(text.tail);
+    }
+    constexpr FixedMyString& append(const MyString& text) { return append(text.view()); }
+    constexpr FixedMyString& append(const char* text) { return append(std::string_view(text)); }
+    constexpr FixedMyString& append(char ch) { return append(std::string_view(&ch, 1)); }
+
+    template<typename Text>
+    constexpr FixedMyString& operator+=(const Text& text) { return append(text); }
+    constexpr void push_back(char ch) { append(ch); }
+
+    template<typename T> requires std::integral<T> && (!std::same_as<T, bool>)
+    FixedMyString& appendNumber(T value, int base = 10) {
+        return appendChars<mystring_chars::maxLength<T>>([=](char* first, char* last) {
+            return std::to_chars(first, last, value, base);
+        });
+    }
+
+    template<std::floating_point T>
+    FixedMyString& appendNumber(T value, std::chars_format format = std::chars_format::general) {
+        return appendChars<mystring_chars::maxLength<T>>(
+                [=](char* first, char* last) { return std::to_chars(first, last, value, format); });
+    }
+
+    [[nodiscard]] constexpr std::size_t find(std::string_view pattern, std::size_t pos = 0) const {
+        return view().find(pattern, pos);
+    }
+    [[nodiscard]] constexpr std::size_t rfind(std::string_view pattern, std::size_t pos = npos) const {
+        return view().rfind(pattern, pos);
+    }
+    [[nodiscard]] constexpr bool contains(std::string_view pattern) const { return find(pattern) != npos; }
+    [[nodiscard]] constexpr std::size_t find_first_of(std::string_view chars, std::size_t pos = 0) const {
+        return view().find_first_of(chars, pos);
+    }
+    [[nodiscard]] constexpr bool startsWith(std::string_view text) const { return view().starts_with(text); }
+    [[nodiscard]] constexpr bool endsWith(std::string_view text) const { return view().ends_with(text); }
+
+    template<typename Predicate>
+    bool all_of(Predicate checker) const {
+        return std::all_of(cbegin(), cend(), checker);
+    }
+
+    /// The content without surrounding whitespace, without copying.
+    [[nodiscard]] constexpr std::string_view trimmed() const {
+        std::size_t begin = 0;
+        std::size_t end = size_;
+        if consteval {
+            while (begin < end && isWhitespace(text_[begin]))
+                ++begin;
+            while (end > begin && isWhitespace(text_[end - 1]))
+                --end;
+        } else {
+            begin = ascii::skipWhitespace(text_.data(), size_);
+            end = begin + ascii::skipWhitespaceBackward(text_.data() + begin, size_ - begin);
+        }
+        return view().substr(begin, end - begin);
+    }
+
+    constexpr void trim() {
+        const std::string_view content = trimmed();
+        std::copy(content.begin(), content.end(), text_.data());
+        size_ = static_cast<SizeType>(content.size());
+    }
+
+    constexpr FixedMyString& toLower() {
+        if consteval {
+            for (char& ch: *this)
+                ch = ('A' <= ch && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+        } else {
+            ascii::toLower(text_.data(), size_);
+        }
+        return *this;
+    }
+
+    constexpr FixedMyString& toUpper() {
+        if consteval {
+            for (char& ch: *this)
+                ch = ('a' <= ch && ch <= 'z') ? static_cast<char>(ch - 'a' + 'A') : ch;
+        } else {
+            ascii::toUpper(text_.data(), size_);
+        }
+        return *this;
+    }
+
+    constexpr FixedMyString& foldCase() { return toLower(); }
+
+    [[nodiscard]] constexpr FixedMyString toLowerCopy() const {
+        FixedMyString copy(*this);
+        return copy.toLower();
+    }
+
+    /// Words are substrings, so they always fit - only the containers allocate.
+    [[nodiscard]] std::set<FixedMyString> getUniqueWords() const {
+        std::set<FixedMyString> uniqueWords;
+        forEachWord<charclass::letters>(view(), [&](std::string_view word) {
+            uniqueWords.insert(FixedMyString(word).toLower());
+        });
+        return uniqueWords;
+    }
+
+    [[nodiscard]] std::map<FixedMyString, std::size_t> countWordsUsageIgnoringCases() const {
+        std::map<FixedMyString, std::size_t> wordCounter;
+        forEachWord<charclass::letters>(view(), [&](std::string_view word) {
+            ++wordCounter[FixedMyString(word).toLower()];
+        });
+        return wordCounter;
+    }
+
+    // Comparisons by content, in the unsigned byte order of MyString and std::string.
+    // Other FixedMyStrings and std::strings take the std::string_view overloads.
+    friend constexpr bool operator==(const FixedMyString& lhs, std::string_view rhs) { return lhs.view() == rhs; }
+    friend constexpr bool operator==(const FixedMyString& lhs, const char* rhs) { return lhs.view() == rhs; }
+    friend constexpr bool operator==(const FixedMyString& lhs, const MyString& rhs) {
+        return lhs.size() == rhs.size() && lhs.compare(rhs.view()) == 0;
+    }
+
+    friend constexpr std::strong_ordering operator<=>(const FixedMyString& lhs, std::string_view rhs) {
+        return lhs.view().compare(rhs) <=> 0;
+    }
+    friend constexpr std::strong_ordering operator<=>(const FixedMyString& lhs, const char* rhs) {
+        return lhs.view().compare(rhs) <=> 0;
+    }
+    friend constexpr std::strong_ordering operator<=>(const FixedMyString& lhs, const MyString& rhs) {
+        return lhs.compare(rhs.view()) <=> 0;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const FixedMyString& text) { return out << text.view(); }
+
+private:
+    constexpr int compare(const MyStringView& other) const {
+        // equal to the head means at least as long as the head, so the rest is compared with the tail
+        const int heads = view().substr(0, other.head.size()).compare(other.head);
+        return heads != 0 ? heads : view().substr(other.head.size()).compare(other.tail);
+    }
+};
+
+/// The same value as std::hash<MyString> for the same content, so both kinds of keys can be mixed.
+template<std::size_t N, OverflowPolicy Policy>
+struct std::hash<FixedMyString<N, Policy>> {
+    constexpr std::size_t operator()(const FixedMyString<N, Policy>& text) const noexcept {
+        const std::string_view content = text.view();
+        const std::uint64_t result = mystring_hash::hashBytes(content.substr(0, MyString::initialBufferSize_), 0);
+        if (content.size() <= static_cast<std::size_t>(MyString::initialBufferSize_))
+            return static_cast<std::size_t>(result);
+        return static_cast<std::size_t>(mystring_hash::hashBytes(content.substr(MyString::initialBufferSize_), result));
+    }
+};
+
+
+#endif //FIXEDMYSTRING_H
@@ -0,0 +1,213 @@
+#include "latencyhistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <ostream>
+
+void LatencyHistogram::record(std::uint64_t nanoseconds) {
+    // the only writer: plain increments published by relaxed stores, no locked instructions in the timed code
+    std::atomic<std::uint64_t>& bucket = counts_[bucketOf(nanoseconds)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+    if (nanoseconds > max_.load(std::memory_order_relaxed))
+        max_.store(nanoseconds, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        if (const std::uint64_t count = other.counts_[bucket].load(std::memory_order_relaxed))
+            counts_[bucket].fetch_add(count, std::memory_order_relaxed);
+    }
+    count_.fetch_add(other.count(), std::memory_order_relaxed);
+    sum_.fetch_add(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    const std::uint64_t otherMax = other.max();
+    std::uint64_t currentMax = max_.load(std::memory_order_relaxed);
+    while (otherMax > currentMax && !max_.compare_exchange_weak(currentMax, otherMax, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& count: counts_)
+        count.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const {
+    const std::uint64_t values = count();
+    return values == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(values);
+}
+
+std::uint64_t LatencyHistogram::percentile(double percent) const {
+    const std::uint64_t values = count();
+    if (values == 0)
+        return 0;
+    const auto wanted = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(
+            std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(values))));
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        seen += counts_[bucket].load(std::memory_order_relaxed);
+        if (seen >= wanted)
+            return std::min(bucketUpperBound(bucket), max());
+    }
+    return max();
+}
+
+/// Values below 2^(subBucketBits + 1) have their own buckets; a value in [2^e, 2^(e+1)) for larger e
+/// keeps its subBucketBits bits after the leading one, e selects the group of 2^subBucketBits buckets.
+std::size_t LatencyHistogram::bucketOf(std::uint64_t nanoseconds) {
+    const std::uint64_t value = std::min(nanoseconds, (std::uint64_t{1} << maxValueBits) - 1);
+    if (value < (std::uint64_t{2} << subBucketBits))
+        return static_cast<std::size_t>(value);
+    const unsigned exponent = static_cast<unsigned>(std::bit_width(value)) - 1;
+    const unsigned shift = exponent - subBucketBits;
+    return (static_cast<std::size_t>(shift + 1) << subBucketBits)
+           + static_cast<std::size_t>((value >> shift) - (std::uint64_t{1} << subBucketBits));
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t bucket) {
+    if (bucket < (std::size_t{2} << subBucketBits))
+        return bucket;
+    const unsigned shift = static_cast<unsigned>(bucket >> subBucketBits) - 1;
+    const std::uint64_t mantissa = (bucket & ((std::size_t{1} << subBucketBits) - 1)) + (std::uint64_t{1} << subBucketBits);
+    return ((mantissa + 1) << shift) - 1;
+}
+
+
+namespace latency {
+
+namespace {
+
+using Histograms = std::array<LatencyHistogram, operationCount>;
+
+class ThreadHistograms;
+
+/// Histograms of the running threads (an intrusive list, so recording never allocates)
+/// and the sum of those which already ended.
+struct Registry {
+    std::mutex mutex;
+    ThreadHistograms* threads{};
+    Histograms finished;
+};
+
+/// Never destroyed (threads and the report at exit may still use it during static destruction)
+/// and created in static storage, so the first recording does not allocate either.
+Registry& registry() {
+    alignas(Registry) static unsigned char storage[sizeof(Registry)];
+    static Registry* const instance = new (storage) Registry;
+    return *instance;
+}
+
+class ThreadHistograms {
+public:
+    ThreadHistograms() {
+        Registry& common = registry();
+        const std::scoped_lock lock(common.mutex);
+        next_ = common.threads;
+        common.threads = this;
+    }
+
+    ~ThreadHistograms() {
+        Registry& common = registry();
+        const std::scoped_lock lock(common.mutex);
+        ThreadHistograms** link = &common.threads;
+        while (*link != this)
+            link = &(*link)->next_;
+        *link = next_;
+        for (std::size_t operation = 0; operation < operationCount; ++operation)
+            common.finished[operation].merge(histograms_[operation]);
+    }
+
+    ThreadHistograms(const ThreadHistograms&) = delete;
+    ThreadHistograms& operator=(const ThreadHistograms&) = delete;
+
+    LatencyHistogram& operator[](std::size_t operation) { return histograms_[operation]; }
+    [[nodiscard]] ThreadHistograms* next() const { return next_; }
+
+private:
+    Histograms histograms_;
+    ThreadHistograms* next_{};
+};
+
+constexpr std::array<double, 4> reportedPercentiles{50, 90, 99, 99.9};
+
+/// Writes the report requested by MYSTRING_LATENCY_FILE when the program ends.
+struct DumpAtExit {
+    ~DumpAtExit() {
+        if (!enabled())
+            return;
+        if (const char* path = std::getenv("MYSTRING_LATENCY_FILE")) {
+            std::ofstream out(path);
+            dumpText(out);
+        }
+    }
+} dumpAtExit;
+
+} // namespace
+
+std::string_view operationName(Operation operation) {
+    constexpr std::array<std::string_view, operationCount> names{
+            "append", "compare", "hash", "trim", "countWords", "uniqueWords"};
+    return names[static_cast<std::size_t>(operation)];
+}
+
+void record(Operation operation, std::uint64_t nanoseconds) {
+    thread_local ThreadHistograms histograms;
+    histograms[static_cast<std::size_t>(operation)].record(nanoseconds);
+}
+
+LatencyHistogram snapshot(Operation operation) {
+    const auto index = static_cast<std::size_t>(operation);
+    Registry& common = registry();
+    const std::scoped_lock lock(common.mutex);
+    LatencyHistogram result(common.finished[index]);
+    for (ThreadHistograms* thread = common.threads; thread; thread = thread->next())
+        result.merge((*thread)[index]);
+    return result;
+}
+
+void reset() {
+    Registry& common = registry();
+    const std::scoped_lock lock(common.mutex);
+    for (auto& histogram: common.finished)
+        histogram.reset();
+    for (ThreadHistograms* thread = common.threads; thread; thread = thread->next())
+        for (std::size_t operation = 0; operation < operationCount; ++operation)
+            (*thread)[operation].reset();
+}
+
+void dumpText(std::ostream& out) {
+    out << "# MyString operation latencies [ns]\n"
+        << "operation count mean p50 p90 p99 p99.9 max\n";
+    for (std::size_t index = 0; index < operationCount; ++index) {
+        const auto operation = static_cast<Operation>(index);
+        const LatencyHistogram histogram = snapshot(operation);
+        out << operationName(operation) << ' ' << histogram.count() << ' ' << static_cast<std::uint64_t>(histogram.mean());
+        for (const double percent: reportedPercentiles)
+            out << ' ' << histogram.percentile(percent);
+        out << ' ' << histogram.max() << '\n';
+    }
+}
+
+void dumpJson(std::ostream& out) {
+    out << "{\n";
+    for (std::size_t index = 0; index < operationCount; ++index) {
+        const auto operation = static_cast<Operation>(index);
+        const LatencyHistogram histogram = snapshot(operation);
+        out << "  \"" << operationName(operation) << "\": {\"count\": " << histogram.count()
+            << ", \"mean\": " << histogram.mean();
+        for (const double percent: reportedPercentiles)
+            out << ", \"p" << percent << "\": " << histogram.percentile(percent);
+        out << ", \"max\": " << histogram.max() << '}' << (index + 1 < operationCount ? ",\n" : "\n");
+    }
+    out << "}\n";
+}
+
+} // namespace latency
@@ -0,0 +1,116 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+
+/// Log-linear (HDR-style) histogram of nanoseconds: exact below 64, above that 32 buckets per power of two,
+/// so a reported value is at most ~3% above the real one. Meant for a single writing thread:
+/// record() is relaxed loads and stores (no read-modify-write), the atomics only let others read or merge it.
+class LatencyHistogram {
+public:
+    static constexpr unsigned subBucketBits = 5;
+    static constexpr unsigned maxValueBits = 40; ///< ~18 minutes, longer values are recorded as that
+    static constexpr std::size_t bucketCount = (maxValueBits - subBucketBits + 1) << subBucketBits;
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram& other) { merge(other); }
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /// Only the owning thread may record.
+    void record(std::uint64_t nanoseconds);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    [[nodiscard]] std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    [[nodiscard]] double mean() const;
+    /// Smallest recorded value (rounded up to its bucket) such that percent % of the values are not larger.
+    [[nodiscard]] std::uint64_t percentile(double percent) const;
+
+    [[nodiscard]] static std::size_t bucketOf(std::uint64_t nanoseconds);
+    [[nodiscard]] static std::uint64_t bucketUpperBound(std::size_t bucket);
+
+private:
+    std::array<std::atomic<std::uint64_t>, bucketCount> counts_{};
+    std::atomic<std::uint64_t> count_{};
+    std::atomic<std::uint64_t> sum_{};
+    std::atomic<std::uint64_t> max_{};
+};
+
+
+/// Latencies of hot MyString operations, recorded only in builds with MYSTRING_LATENCY_HISTOGRAMS defined
+/// (CMake option of the same name; always on in the tests target). Every thread records into its own
+/// histograms, which are merged when read, and added to a common one when the thread ends.
+/// When the environment variable MYSTRING_LATENCY_FILE is set, a text report is written there at exit.
+namespace latency {
+
+enum class Operation {
+    append,     ///< append() and operator+=(const MyString&)
+    compare,    ///< operator<=>
+    hash,       ///< std::hash<MyString>
+    trim,
+    countWords, ///< countWordsUsageIgnoringCases()
+    uniqueWords ///< getUniqueWords()
+};
+inline constexpr std::size_t operationCount = 6;
+
+[[nodiscard]] std::string_view operationName(Operation operation);
+
+[[nodiscard]] constexpr bool enabled() {
+#ifdef MYSTRING_LATENCY_HISTOGRAMS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void record(Operation operation, std::uint64_t nanoseconds);
+/// Merged histograms of all threads.
+[[nodiscard]] LatencyHistogram snapshot(Operation operation);
+/// Meant for moments when no other thread records - a sample recorded meanwhile may undo part of the reset.
+void reset();
+
+/// Per operation: count, mean, p50, p90, p99, p99.9 and max in nanoseconds.
+void dumpText(std::ostream& out);
+void dumpJson(std::ostream& out);
+
+/// Records the lifetime of the object when latency histograms are enabled, otherwise does nothing.
+/// Nothing is measured during constant evaluation, so it can be used in constexpr functions.
+class Timer {
+public:
+    constexpr explicit Timer(Operation operation) : operation_(operation) {
+        if constexpr (enabled()) {
+            if !consteval {
+                start_ = std::chrono::steady_clock::now();
+            }
+        }
+    }
+
+    constexpr ~Timer() {
+        if constexpr (enabled()) {
+            if !consteval {
+                const auto elapsed = std::chrono::steady_clock::now() - start_;
+                record(operation_, static_cast<std::uint64_t>(std::chrono::nanoseconds(elapsed).count()));
+            }
+        }
+    }
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+private:
+    Operation operation_;
+    std::chrono::steady_clock::time_point start_{};
+};
+
+} // namespace latency
+
+
+#endif //LATENCYHISTOGRAM_H
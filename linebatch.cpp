@@ -0,0 +1,96 @@
+#include "linebatch.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <istream>
+#include <system_error>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/// Appends offset + index of every '\n' in data to positions.
+void findNewlines(const char* data, std::size_t length, std::size_t offset, std::vector<std::size_t>& positions) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; i + 16 <= length; i += 16) {
+        auto found = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), newline)));
+        while (found != 0) {
+            positions.push_back(offset + i + std::countr_zero(found));
+            found &= found - 1;
+        }
+    }
+#endif
+    for (; i < length; ++i)
+        if (data[i] == '\n')
+            positions.push_back(offset + i);
+}
+
+} // namespace
+
+
+LineBatchReader::LineBatchReader(std::istream& in, std::size_t blockSize)
+        : in_(&in), blockSize_(std::max<std::size_t>(blockSize, 1)) {
+}
+
+LineBatchReader::LineBatchReader(int fd, std::size_t blockSize)
+        : fd_(fd), blockSize_(std::max<std::size_t>(blockSize, 1)) {
+}
+
+bool LineBatchReader::next(LineBatch& batch) {
+    std::string& arena = batch.arena_;
+    batch.lines_.clear();
+    arena.assign(carry_);
+    carry_.clear();
+    newlines_.clear();
+
+    // the carried line has no '\n', so only new bytes are scanned; read until some line is complete
+    while (!finished_ && newlines_.empty()) {
+        const std::size_t oldSize = arena.size();
+        arena.resize_and_overwrite(oldSize + blockSize_, [&](char* data, std::size_t) {
+            return oldSize + readSome(data + oldSize, blockSize_);
+        });
+        if (arena.size() == oldSize)
+            finished_ = true;
+        else
+            findNewlines(arena.data() + oldSize, arena.size() - oldSize, oldSize, newlines_);
+    }
+
+    // views are created only now - the arena does not move anymore
+    batch.lines_.reserve(newlines_.size() + 1);
+    std::size_t lineBegin = 0;
+    for (const std::size_t newline: newlines_) {
+        batch.lines_.emplace_back(arena.data() + lineBegin, newline - lineBegin);
+        lineBegin = newline + 1;
+    }
+    if (lineBegin < arena.size()) {
+        if (finished_) {
+            batch.lines_.emplace_back(arena.data() + lineBegin, arena.size() - lineBegin);
+        } else {
+            carry_.assign(arena, lineBegin);
+            arena.resize(lineBegin);
+        }
+    }
+    return !batch.lines_.empty();
+}
+
+std::size_t LineBatchReader::readSome(char* destination, std::size_t count) {
+    if (in_ != nullptr) {
+        in_->read(destination, static_cast<std::streamsize>(count));
+        finished_ = in_->eof(); // saves one more, empty, read
+        return static_cast<std::size_t>(in_->gcount());
+    }
+    while (true) {
+        const ssize_t read = ::read(fd_, destination, count);
+        if (read >= 0)
+            return static_cast<std::size_t>(read);
+        if (errno != EINTR)
+            throw std::system_error(errno, std::generic_category(), "LineBatchReader: read failed");
+    }
+}
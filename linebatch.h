@@ -0,0 +1,73 @@
+#ifndef LINEBATCH_H
+#define LINEBATCH_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mystring.h"
+
+
+/// Lines of one batch: views into a single buffer (arena) owned by the batch.
+/// Views stay valid until the batch is passed to LineBatchReader::next() again or destroyed.
+/// Lines do not contain the '\n' separator ('\r' of "\r\n" is kept - as in std::getline).
+class LineBatch {
+public:
+    using const_iterator = std::vector<std::string_view>::const_iterator;
+
+    [[nodiscard]] std::size_t size() const { return lines_.size(); }
+    [[nodiscard]] bool empty() const { return lines_.empty(); }
+
+    [[nodiscard]] std::string_view operator[](std::size_t index) const { return lines_[index]; }
+    [[nodiscard]] std::string_view at(std::size_t index) const { return lines_.at(index); }
+    /// For MyString algorithms taking MyStringView (forEachWord, search::find, MyStringMatcher::scan).
+    [[nodiscard]] MyStringView view(std::size_t index) const { return {lines_[index], {}}; }
+
+    [[nodiscard]] const_iterator begin() const { return lines_.begin(); }
+    [[nodiscard]] const_iterator end() const { return lines_.end(); }
+
+    /// Bytes of all lines with their separators.
+    [[nodiscard]] std::size_t bytes() const { return arena_.size(); }
+
+private:
+    friend class LineBatchReader;
+
+    std::string arena_;
+    std::vector<std::string_view> lines_;
+};
+
+
+/// Splits a stream or a file descriptor into lines, reading it in big blocks:
+/// every batch is one read of at least blockSize bytes into the arena of the batch
+/// (more when a line is longer than a block), newlines are found 16 bytes at a time with SSE2.
+/// Only the unfinished last line of a block is copied - to the beginning of the next batch.
+/// Passing the same batch to next() again reuses its buffers, so in a steady state nothing is allocated.
+class LineBatchReader {
+public:
+    static constexpr std::size_t defaultBlockSize = 1 << 20;
+
+    explicit LineBatchReader(std::istream& in, std::size_t blockSize = defaultBlockSize);
+    /// The descriptor is not closed by the reader.
+    explicit LineBatchReader(int fd, std::size_t blockSize = defaultBlockSize);
+
+    /// Replaces the content of batch with the next lines.
+    /// @return false when the input is exhausted (batch is empty then)
+    /// @throw std::system_error when reading the descriptor fails
+    bool next(LineBatch& batch);
+
+private:
+    std::istream* in_{};
+    int fd_{-1};
+    std::size_t blockSize_;
+    std::string carry_; ///< unfinished last line of the previous block
+    std::vector<std::size_t> newlines_;
+    bool finished_{};
+
+    /// @return number of bytes read, 0 only at the end of input (a stream sets finished_ already on a short read)
+    std::size_t readSome(char* destination, std::size_t count);
+};
+
+
+#endif //LINEBATCH_H
@@ -1,275 +1,235 @@
 #include "mystring.h"
+#include "asciikernels.h"
+#include "stringsearch.h"
+#include "wordtokenizer.h"
 
 #include <algorithm>
-#include <cstring>
 #include <random>
 #include <ranges>
 
-MyString::MyString(const char* text) {
-    size_ = std::strlen(text);
-    const std::size_t smallCount = std::min(size_, static_cast<std::size_t>(initialBufferSize_));
-    std::copy_n(text, smallCount, smallText_.begin());
-
-    if (smallCount < initialBufferSize_) {
-        smallText_[smallCount] = '\0';
-    }
+namespace {
 
-    if (size_ > initialBufferSize_) {
-        bigText_.assign(text + smallCount, size_ - smallCount);
-    } else {
-        bigText_.clear();
+/// Writes count fill characters in blocks from a stack buffer rather than one put() each.
+bool writePadding(std::streambuf& buffer, char fill, std::streamsize count) {
+    std::array<char, 64> fills;
+    fills.fill(fill);
+    while (count > 0) {
+        const std::streamsize block = std::min(count, static_cast<std::streamsize>(fills.size()));
+        if (buffer.sputn(fills.data(), block) != block)
+            return false;
+        count -= block;
     }
-    capacity_ = initialBufferSize_ + bigText_.capacity();
+    return true;
 }
 
-MyString::MyString(std::size_t length, char c) {
-    if (length <= initialBufferSize_) {
-        std::fill_n(smallText_.begin(), length, c);
-        if (length < initialBufferSize_)
-            smallText_[length] = '\0';
-    } else {
-        std::ranges::fill(smallText_, c);
-        bigText_.assign(length - initialBufferSize_, c);
-    }
-    size_ = length;
-    capacity_ = initialBufferSize_ + bigText_.capacity();
+bool writePiece(std::streambuf& buffer, std::string_view piece) {
+    const auto length = static_cast<std::streamsize>(piece.size());
+    return piece.empty() || buffer.sputn(piece.data(), length) == length;
 }
 
+} // namespace
 
-void MyString::clear() {
-    size_ = 0;
-    if (capacity_ <= initialBufferSize_) {
-        smallText_[0] = '\0';
-    } else {
-        bigText_.clear();
-    }
-}
-
+/// Like the std::string inserter: a sentry first (flushes tie(), nothing is written to a failed stream),
+/// padding to width(), badbit on a short write.
 std::ostream& operator<<(std::ostream& out, const MyString& str) {
-    std::size_t smallCount = std::min(str.size_, static_cast<std::size_t>(MyString::initialBufferSize_));
-    out << std::string(str.smallText_.data(), smallCount);
-    if (str.size_ > MyString::initialBufferSize_) {
-        out << str.bigText_;
-    }
+    const std::ostream::sentry ready(out);
+    if (!ready)
+        return out;
+
+    const MyStringView pieces = str.view();
+    const auto length = static_cast<std::streamsize>(pieces.size());
+    const std::streamsize padding = out.width() > length ? out.width() - length : 0;
+    const bool padLeft = (out.flags() & std::ios_base::adjustfield) != std::ios_base::left;
+    std::streambuf& buffer = *out.rdbuf();
+
+    const bool written = (!padLeft || writePadding(buffer, out.fill(), padding))
+                         && writePiece(buffer, pieces.head) && writePiece(buffer, pieces.tail)
+                         && (padLeft || writePadding(buffer, out.fill(), padding));
+    out.width(0);
+    if (!written)
+        out.setstate(std::ios_base::badbit);
     return out;
 }
 
 std::istream& operator>>(std::istream& in, MyString& str) {
-    std::string tmp;
-    if (!std::getline(in, tmp))
+    str.size_ = 0;
+    str.bigText_.clear();
+    str.smallText_[0] = '\0';
+    const std::istream::sentry ready(in, true);
+    if (!ready)
         return in;
-    str = MyString(tmp.c_str());
-    return in;
-}
-
-char& MyString::operator[](std::size_t index) {
-    if (index >= size_)
-        throw std::out_of_range("MyString::operator[]: invalid index");
-    return index < initialBufferSize_ ? smallText_[index] : bigText_[index - initialBufferSize_];
-}
-
-const char& MyString::operator[](std::size_t index) const {
-    if (index >= size_)
-        throw std::out_of_range("MyString::operator[]: invalid index");
-    return index < initialBufferSize_ ? smallText_[index] : bigText_[index - initialBufferSize_];
-}
-
-MyString& MyString::operator+=(char ch) {
-    if (size_ < initialBufferSize_)
-        smallText_[size_] = ch;
-    else
-        bigText_ += ch;
 
-    size_++;
-    capacity_ = initialBufferSize_ + bigText_.capacity();
-    if (size_ < initialBufferSize_)
-        smallText_[size_] = '\0';
-
-    return *this;
-}
-
-MyString& MyString::operator+=(const MyString& other) {
-    std::copy(other.begin(), other.end(), std::back_inserter(*this));
-    //back_inserter uzywa wielokrotnie (push_back(value_type))
-    return *this;
-}
-
-
-std::strong_ordering MyString::operator<=>(const MyString& other) const {
-    std::size_t min_len = std::min(size_, other.size_);
-    for (std::size_t i = 0; i < min_len; ++i) {
-        std::strong_ordering cmp = (*this)[i] <=> other[i];
-        if (cmp != std::strong_ordering::equal)
-            return cmp;
+    using traits = std::istream::traits_type;
+    std::streambuf* const buffer = in.rdbuf();
+    for (;;) {
+        const traits::int_type ch = buffer->sbumpc();
+        if (traits::eq_int_type(ch, traits::eof())) {
+            in.setstate(str.size_ == 0 ? std::ios_base::eofbit | std::ios_base::failbit : std::ios_base::eofbit);
+            break;
+        }
+        if (traits::eq_int_type(ch, traits::to_int_type('\n')))
+            break;
+        str.smallText_[str.size_++] = traits::to_char_type(ch);
+        if (str.size_ == MyString::initialBufferSize_) {
+            // the rest of the line directly into the heap part; nothing more than the end of the stream is not an error
+            if (!std::getline(in, str.bigText_) && in.eof() && !in.bad())
+                in.clear(std::ios_base::eofbit);
+            if constexpr (stringstats::enabled()) {
+                if (!str.bigText_.empty())
+                    stringstats::recordSpill();
+            }
+            str.size_ += str.bigText_.size();
+            break;
+        }
     }
-    return size_ <=> other.size_;
+    if (str.size_ < MyString::initialBufferSize_)
+        str.smallText_[str.size_] = '\0';
+    str.updateCapacity();
+    return in;
 }
 
+namespace {
 
-void MyString::trim() {
-    if (size_ == 0)
-        return;
-
-    std::size_t begin = 0;
-    std::size_t end = size_;
-    //isspace przyjmuje tylko unsigned char -> CAST
-    while (begin < size_ && std::isspace(static_cast<unsigned char>((*this)[begin]))) {
-        begin++;
-    }
-
-    if (begin == size_) {
-        clear();
-        return;
-    }
-
-    while (end > begin && std::isspace(static_cast<unsigned char>((*this)[end - 1]))) {
-        end--;
-    }
+/// Number of characters left in a seekable stream, 0 when it cannot be found out.
+std::size_t remainingLength(std::istream& in) {
+    const std::istream::pos_type start = in.tellg();
+    if (start == std::istream::pos_type(-1))
+        return 0;
+    in.seekg(0, std::ios_base::end);
+    const std::istream::pos_type end = in.tellg();
+    in.seekg(start);
+    return end > start ? static_cast<std::size_t>(end - start) : 0;
+}
 
-    std::size_t newSize = end - begin;
+} // namespace
 
-    if (begin > 0) {
-        //przesuniecie na początku
-        for (std::size_t i = 0; i < newSize; ++i) {
-            (*this)[i] = (*this)[i + begin];
-        }
-    }
-    size_ = newSize;
+MyString MyString::readAll(std::istream& in) {
+    constexpr std::size_t chunkSize = 1 << 16;
+    using traits = std::istream::traits_type;
 
-    if (size_ <= initialBufferSize_) {
-        bigText_.clear();
-        if (size_ < initialBufferSize_) {
-            smallText_[size_] = '\0';
+    MyString result;
+    const std::size_t expectedLength = remainingLength(in);
+    result.reserve(expectedLength);
+
+    in.read(result.smallText_.data(), initialBufferSize_);
+    result.size_ = static_cast<std::size_t>(in.gcount());
+    if (result.size_ == initialBufferSize_) {
+        std::size_t wanted = expectedLength > initialBufferSize_ ? expectedLength - initialBufferSize_ : chunkSize;
+        while (!traits::eq_int_type(in.peek(), traits::eof())) {
+            const std::size_t oldSize = result.bigText_.size();
+            result.bigText_.resize_and_overwrite(oldSize + wanted, [&](char* big, std::size_t) {
+                in.read(big + oldSize, static_cast<std::streamsize>(wanted));
+                return oldSize + static_cast<std::size_t>(in.gcount());
+            });
+            wanted = chunkSize;
         }
+        result.size_ += result.bigText_.size();
     } else {
-        bigText_.erase(size_ - initialBufferSize_);
+        result.smallText_[result.size_] = '\0';
     }
+    if (in.eof() && !in.bad())
+        in.clear(std::ios_base::eofbit); // reaching the end is the purpose, not a failure
+    result.updateCapacity();
+    result.recordConstruction();
+    return result;
 }
 
-MyString& MyString::toLower() {
-    for (auto& ch: *this) {
-        ch = std::tolower(static_cast<unsigned char>(ch));
-    }
-    return *this;
+MyString MyString::toLowerCopy() const {
+    MyString result;
+    toLowerCopy(result);
+    return result;
+}
+
+void MyString::toLowerCopy(MyString& destination) const {
+    const std::size_t smallCount = std::min(size_, static_cast<std::size_t>(initialBufferSize_));
+    destination.bigText_.resize(bigText_.size());
+    ascii::toLowerCopy(smallText_.data(), destination.smallText_.data(), smallCount);
+    ascii::toLowerCopy(bigText_.data(), destination.bigText_.data(), bigText_.size());
+
+    destination.size_ = size_;
+    if (smallCount < initialBufferSize_)
+        destination.smallText_[smallCount] = '\0';
+    destination.updateCapacity();
 }
 
 
 std::set<MyString> MyString::getUniqueWords() const {
+    const latency::Timer timer(latency::Operation::uniqueWords);
     std::set<MyString> uniqueWords;
-    MyString tmp = *this;
-    tmp.trim();
-    tmp = tmp.toLower();
-
-    MyString currentWord;
-    for (const auto ch: tmp) {
-        if (!std::isspace(static_cast<unsigned char>(ch))
-            && std::isalpha(static_cast<unsigned>(ch))) {
-            currentWord += ch;
-        } else {
-            if (!currentWord.empty()) {
-                uniqueWords.insert(currentWord);
-                currentWord.clear();
-            }
-        }
-    }
-    if (!currentWord.empty()) {
-        uniqueWords.insert(currentWord);
-    }
-
+    forEachWord<charclass::letters>(*this, [&](std::string_view word) {
+        MyString lowerWord(word);
+        lowerWord.toLower();
+        uniqueWords.insert(std::move(lowerWord));
+    });
     return uniqueWords;
 }
 
 std::map<MyString, size_t> MyString::countWordsUsageIgnoringCases() const {
-    MyString tmp = *this;
-    tmp.trim();
-    tmp = tmp.toLower();
-
+    const latency::Timer timer(latency::Operation::countWords);
     std::map<MyString, size_t> wordCounter;
-    MyString currentWord;
-
-    auto addWordToCounter = [&] {
-        if (!currentWord.empty()) {
-            ++wordCounter[currentWord];
-            currentWord.clear();
-        }
-    };
-
-    for (const auto ch: tmp) {
-        if (std::isalpha(static_cast<unsigned>(ch)))
-            currentWord += ch;
-        else
-            addWordToCounter();
-    }
-    addWordToCounter();
-
+    forEachWord<charclass::letters>(*this, [&](std::string_view word) {
+        MyString lowerWord(word);
+        ++wordCounter[lowerWord.toLower()];
+    });
     return wordCounter;
 }
 
 
 std::string MyString::toString() const {
-    std::string res;
-    for (const auto ch: *this)
-        res += ch;
-    return res;
+    return view().toString();
 }
 
-auto makeRandomCharGenerator() {
-    return [] {
-        constexpr std::string_view alphabet = "abcdefghijklmnopqrstuvwxyz";
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<size_t> dist(0, alphabet.length() - 1);
-
-        return alphabet[dist(gen)];
-    };
+namespace {
+FastRandom& threadRandomGenerator() {
+    thread_local FastRandom generator{(std::uint64_t{std::random_device{}()} << 32) | std::random_device{}()};
+    return generator;
 }
+} // namespace
 
 MyString MyString::generateRandomWord(size_t length) {
+    return generateRandomWord(length, threadRandomGenerator());
+}
+
+MyString MyString::generateRandomWord(size_t length, FastRandom& generator) {
     if (length == 0)
         return {};
 
     MyString randomWord(length, '\0');
-    auto generator = makeRandomCharGenerator();
-    std::generate_n(randomWord.begin(), length, generator);
+    generator.fillLowercaseLetters(randomWord.smallText_.data(), std::min(length, static_cast<std::size_t>(initialBufferSize_)));
+    generator.fillLowercaseLetters(randomWord.bigText_.data(), randomWord.bigText_.size());
     return randomWord;
 }
 
-bool MyString::startsWith(const MyString& txt) const {
-    for (std::size_t i = 0, j = 0; j < txt.size_; ++j, ++i) {
-        if ((*this)[i] != txt[j]) {
-            return false;
-        }
-    }
-    return true;
+void MyString::seedRandomWords(std::uint64_t seed) {
+    threadRandomGenerator().seed(seed);
 }
 
-bool MyString::endsWith(const MyString& txt) const {
-    //return this->toString().ends_with(txt.toString());
+std::size_t MyString::find(std::string_view pattern, std::size_t pos) const {
+    return search::find(view(), pattern, pos);
+}
 
-    for (int i = size_ - 1, j = txt.size_ - 1; j >= 0; --j, --i) {
-        if ((*this)[i] != txt[j]) {
-            return false;
-        }
-    }
-    return true;
+std::size_t MyString::find(const MyString& pattern, std::size_t pos) const {
+    if (pattern.bigText_.empty())
+        return find(pattern.view().head, pos);
+    const std::string contiguous = pattern.view().toString(); // the pattern searched for has to be contiguous
+    return find(std::string_view(contiguous), pos);
 }
 
-MyString MyString::join(const std::vector<MyString>& texts) const {
-    if (texts.empty())
-        return {};
+std::size_t MyString::rfind(std::string_view pattern, std::size_t pos) const {
+    return search::rfind(view(), pattern, pos);
+}
 
-    auto it = std::begin(texts), end = std::end(texts);
-    MyString result;
-    result += *it;
-    ++it;
+std::size_t MyString::rfind(const MyString& pattern, std::size_t pos) const {
+    if (pattern.bigText_.empty())
+        return rfind(pattern.view().head, pos);
+    const std::string contiguous = pattern.view().toString(); // the pattern searched for has to be contiguous
+    return rfind(std::string_view(contiguous), pos);
+}
 
-    while (it != end) {
-        result += *this;
-        result += *it;
-        ++it;
-    }
-    result.bigText_.shrink_to_fit();
-    result.capacity_ = result.bigText_.capacity() + initialBufferSize_;
-    return result;
+std::size_t MyString::find_first_of(std::string_view chars, std::size_t pos) const {
+    return search::findFirstOf(view(), chars, pos);
 }
 
+std::vector<std::size_t> MyString::find_all(std::string_view pattern) const {
+    return search::findAll(view(), pattern);
+}
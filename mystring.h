@@ -3,17 +3,129 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <limits>
+#include <optional>
 #include <iostream>
 #include <map>
 #include <set>
+#include <stdexcept>
+#include <span>
 #include <compare>
+#include <cstdint>
 #include <iterator>
+#include <string>
+#include <string_view>
+#include <numeric>
+#include <ranges>
+#include <thread>
+#include <utility>
 #include <vector>
+#include <version>
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
 
+#include "allocationcounter.h"
+#include "asciikernels.h"
+#include "fastrandom.h"
+#include "latencyhistogram.h"
+#include "mystringstats.h"
+
+/// Size of the inline buffer, can be chosen per build (see tools/inlineCapacityRecommender.cpp).
+#ifndef MYSTRING_INLINE_CAPACITY
+#define MYSTRING_INLINE_CAPACITY 20
+#endif
+
+
+/// std::to_chars helpers shared by MyString, MyStringBuilder and FixedMyString.
+namespace mystring_chars {
+
+/// Longest text std::to_chars writes for a value of T.
+template<typename T>
+inline constexpr std::size_t maxLength =
+        std::numeric_limits<T>::max_exponent10 + std::numeric_limits<T>::max_digits10 + 8;
+/// The sign and every digit in base 2 - the most negative value has one digit more than numeric_limits<T>::digits.
+template<std::integral T>
+inline constexpr std::size_t maxLength<T> = std::numeric_limits<std::make_unsigned_t<T>>::digits + 1;
+
+/// Writes what toChars(first, last) -> std::to_chars_result writes.
+/// @return end of the written text, first when to_chars failed (nothing is written then)
+template<typename ToChars>
+char* write(char* first, char* last, ToChars toChars) {
+    const auto [end, error] = toChars(first, last);
+    return error == std::errc() ? end : first;
+}
+
+/// Text of toChars formatted into a stack buffer of MaxLength characters, empty when to_chars failed.
+template<std::size_t MaxLength>
+class Buffer {
+public:
+    template<typename ToChars>
+    explicit Buffer(ToChars toChars)
+            : size_(static_cast<std::size_t>(write(text_.data(), text_.data() + MaxLength, toChars) - text_.data())) {}
+
+    [[nodiscard]] std::string_view view() const { return {text_.data(), size_}; }
+
+private:
+    std::array<char, MaxLength> text_;
+    std::size_t size_;
+};
+
+} // namespace mystring_chars
+
+
+/// Non-owning view of MyString content made of two contiguous pieces
+/// (for a whole string: the inline part followed by the heap part).
+struct MyStringView {
+    std::string_view head;
+    std::string_view tail;
+
+    [[nodiscard]] constexpr std::size_t size() const { return head.size() + tail.size(); }
+    [[nodiscard]] constexpr bool empty() const { return head.empty() && tail.empty(); }
+
+    [[nodiscard]] constexpr char operator[](std::size_t index) const {
+        return index < head.size() ? head[index] : tail[index - head.size()];
+    }
+
+    [[nodiscard]] constexpr MyStringView substr(std::size_t pos, std::size_t count = std::string_view::npos) const {
+        count = std::min(count, size() - pos);
+        if (pos >= head.size())
+            return {tail.substr(pos - head.size(), count), {}};
+        const std::string_view headPart = head.substr(pos, count);
+        return {headPart, tail.substr(0, count - headPart.size())};
+    }
+
+    [[nodiscard]] constexpr std::string toString() const {
+        std::string result;
+        result.reserve(size());
+        result.append(head).append(tail);
+        return result;
+    }
+
+    friend constexpr bool operator==(const MyStringView& lhs, std::string_view rhs) {
+        return lhs.size() == rhs.size()
+               && lhs.head == rhs.substr(0, lhs.head.size())
+               && lhs.tail == rhs.substr(lhs.head.size());
+    }
+
+    friend constexpr bool operator==(const MyStringView& lhs, const MyStringView& rhs) {
+        return lhs.size() == rhs.size()
+               && rhs.substr(0, lhs.head.size()) == lhs.head
+               && rhs.substr(lhs.head.size()) == lhs.tail;
+    }
+};
+
+template<std::size_t N>
+class MyStringConcat;
 
 class MyString {
 public:
-    static constexpr int initialBufferSize_ = 20;
+    static constexpr int initialBufferSize_ = MYSTRING_INLINE_CAPACITY;
+    static_assert(initialBufferSize_ >= 1, "MYSTRING_INLINE_CAPACITY has to be positive");
+    static constexpr std::size_t npos = std::string_view::npos;
     using value_type = char;
     using reference = char&;
     using const_reference = const char&;
@@ -21,18 +133,153 @@ public:
 
 
 private:
-    std::array<char, 20> smallText_{};
-    std::string bigText_;
+#ifdef MYSTRING_COUNT_ALLOCATIONS
+    using BigText = std::basic_string<char, std::char_traits<char>, allocations::CountingAllocator<char>>;
+#else
+    using BigText = std::string;
+#endif
+
+    std::array<char, initialBufferSize_> smallText_{};
+    BigText bigText_;
     std::size_t capacity_{initialBufferSize_ + bigText_.capacity()};
     std::size_t size_{};
 
+    /// Recomputes capacity_ after bigText_ changed, recording heap growth in the statistics.
+    constexpr void updateCapacity() {
+        const std::size_t newCapacity = initialBufferSize_ + bigText_.capacity();
+        if constexpr (stringstats::enabled()) {
+            if !consteval {
+                if (newCapacity > capacity_)
+                    stringstats::recordHeapGrowth(size_, capacity_ <= initialBufferSize_ + BigText().capacity());
+            }
+        }
+        capacity_ = newCapacity;
+    }
+
+    constexpr void recordConstruction() const {
+        if constexpr (stringstats::enabled()) {
+            if !consteval {
+                stringstats::recordConstruction(size_);
+            }
+        }
+    }
+
+    /// Records a spill past the inline buffer when growing from oldSize to size_.
+    constexpr void recordSpill(std::size_t oldSize) const {
+        if constexpr (stringstats::enabled()) {
+            if !consteval {
+                if (oldSize <= initialBufferSize_ && size_ > initialBufferSize_)
+                    stringstats::recordSpill();
+            }
+        }
+    }
+
+    [[nodiscard]] static constexpr bool isWhitespace(char ch) {
+        return ch == ' ' || ('\t' <= ch && ch <= '\r');
+    }
+
+    /// @return [begin, end) of the content without leading and trailing whitespace
+    [[nodiscard]] static constexpr std::pair<std::size_t, std::size_t> trimmedBounds(const MyStringView& text);
+
+    /// Output iterator writing to [position, pieceEnd) and then from next on - the inline and the heap part.
+    class SplitOutput {
+    public:
+        using difference_type = std::ptrdiff_t;
+
+        SplitOutput(char* position, char* pieceEnd, char* next)
+                : position_(position == pieceEnd ? next : position), pieceEnd_(pieceEnd), next_(next) {}
+
+        char& operator*() const { return *position_; }
+        SplitOutput& operator++() {
+            if (++position_ == pieceEnd_)
+                position_ = next_;
+            return *this;
+        }
+        SplitOutput operator++(int) {
+            SplitOutput previous = *this;
+            ++*this;
+            return previous;
+        }
+
+    private:
+        char* position_;
+        char* pieceEnd_;
+        char* next_;
+    };
+    static_assert(std::output_iterator<SplitOutput, char>);
+
+    /// Appends what toChars(first, last) -> std::to_chars_result writes, MaxLength is enough for any value
+    /// (mystring_chars::maxLength); a failed to_chars appends nothing.
+    template<std::size_t MaxLength, typename ToChars>
+    MyString& appendChars(ToChars toChars) {
+        if (size_ < initialBufferSize_) {
+            char* const first = smallText_.data() + size_;
+            const auto [last, error] = toChars(first, smallText_.data() + initialBufferSize_);
+            if (error == std::errc()) {
+                size_ += static_cast<std::size_t>(last - first);
+                if (size_ < initialBufferSize_)
+                    smallText_[size_] = '\0';
+                return *this;
+            }
+            const mystring_chars::Buffer<MaxLength> formatted(toChars);
+            appendPieces({formatted.view(), {}});
+            return *this;
+        }
+
+        const std::size_t oldSize = bigText_.size();
+        bigText_.resize_and_overwrite(oldSize + MaxLength, [&](char* data, std::size_t) {
+            return static_cast<std::size_t>(mystring_chars::write(data + oldSize, data + oldSize + MaxLength, toChars)
+                                            - data);
+        });
+        size_ += bigText_.size() - oldSize;
+        updateCapacity();
+        return *this;
+    }
+
+    template<std::size_t N>
+    friend class MyStringConcat;
+
+    /// The pieces one after another, allocated once.
+    constexpr explicit MyString(std::span<const MyStringView> pieces);
+
+    /// append() without a latency sample: every public overload records one sample and calls this once,
+    /// members building a string from many pieces (join) call it directly.
+    constexpr void appendPieces(const MyStringView& text);
+
+    static constexpr MyStringView piecesOf(const MyString& text) { return text.view(); }
+    static constexpr MyStringView piecesOf(const MyStringView& text) { return text; }
+    static constexpr MyStringView piecesOf(std::string_view text) { return {text, {}}; }
+    static constexpr MyStringView piecesOf(const char* text) { return {text, {}}; }
+
+    /// Copies text to position offset of the content (inline part, or big - the heap part's buffer).
+    /// @return offset just after the copied text
+    constexpr std::size_t writeAt(std::size_t offset, const MyStringView& text, char* big) {
+        for (const std::string_view piece: {text.head, text.tail}) {
+            std::size_t copied = 0;
+            if (offset < initialBufferSize_) {
+                copied = std::min(piece.size(), initialBufferSize_ - offset);
+                std::copy_n(piece.data(), copied, smallText_.data() + offset);
+            }
+            if (copied < piece.size())
+                std::copy_n(piece.data() + copied, piece.size() - copied, big + (offset + copied - initialBufferSize_));
+            offset += piece.size();
+        }
+        return offset;
+    }
+
 public:
-    MyString() = default;
+    constexpr MyString() = default;
 
-    MyString(const char* text);
-    MyString(std::size_t length, char ch);
+    constexpr MyString(const char* text) : MyString(std::string_view(text)) {}
+    constexpr explicit MyString(std::string_view text) : MyString(MyStringView{text, {}}) {}
+    constexpr explicit MyString(const MyStringView& text) : MyString(std::span<const MyStringView>(&text, 1)) {}
+    constexpr MyString(std::size_t length, char ch);
 
-    MyString(const MyString& other) = default;
+    constexpr MyString(const MyString& other);
+    /// Takes over the heap part, other is left empty.
+    constexpr MyString(MyString&& other) noexcept;
+    constexpr MyString& operator=(const MyString& other);
+    constexpr MyString& operator=(MyString&& other) noexcept;
 
     template<bool IsConst>
     class base_iterator {
@@ -49,45 +296,45 @@ public:
         std::size_t index_;
 
     public:
-        base_iterator(string_pointer_type str, std::size_t index) : str_(str), index_(index) {}
+        constexpr base_iterator(string_pointer_type str, std::size_t index) : str_(str), index_(index) {}
 
 
-        reference operator*() const { return (*str_)[index_]; }
-        pointer operator->() const { return &(*str_)[index_]; }
+        constexpr reference operator*() const { return (*str_)[index_]; }
+        constexpr pointer operator->() const { return &(*str_)[index_]; }
 
-        base_iterator& operator++() {
+        constexpr base_iterator& operator++() {
             ++index_;
             return *this;
         }
 
-        base_iterator operator++(int) {
+        constexpr base_iterator operator++(int) {
             base_iterator tmp = *this;
             ++index_;
             return tmp;
         }
-        base_iterator& operator--() {
+        constexpr base_iterator& operator--() {
             --index_;
             return *this;
         }
 
-        base_iterator operator--(int) {
+        constexpr base_iterator operator--(int) {
             base_iterator tmp = *this;
             --index_;
             return tmp;
         }
 
-        base_iterator& operator+=(difference_type n) { index_ += n; return *this; }
-        base_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+        constexpr base_iterator& operator+=(difference_type n) { index_ += n; return *this; }
+        constexpr base_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
 
-        friend base_iterator operator+(base_iterator it, difference_type n) { it += n; return it; }
-        friend base_iterator operator+(difference_type n, base_iterator it) { it += n; return it; }
-        friend base_iterator operator-(base_iterator it, difference_type n) { it -= n; return it; }
+        friend constexpr base_iterator operator+(base_iterator it, difference_type n) { it += n; return it; }
+        friend constexpr base_iterator operator+(difference_type n, base_iterator it) { it += n; return it; }
+        friend constexpr base_iterator operator-(base_iterator it, difference_type n) { it -= n; return it; }
 
-        difference_type operator-(const base_iterator& other) const {
+        constexpr difference_type operator-(const base_iterator& other) const {
             return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
         }
 
-        reference operator[](difference_type n) const {
+        constexpr reference operator[](difference_type n) const {
             return *(*this + n);
         }
 
@@ -95,8 +342,8 @@ public:
 
 
 
-        bool operator==(const base_iterator& other) const { return index_ == other.index_; }
-        bool operator!=(const base_iterator& other) const { return index_ != other.index_; }
+        constexpr bool operator==(const base_iterator& other) const { return index_ == other.index_; }
+        constexpr bool operator!=(const base_iterator& other) const { return index_ != other.index_; }
     };
 
     using iterator = base_iterator<false>;
@@ -104,12 +351,12 @@ public:
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-    iterator begin() { return {this, 0}; }
-    iterator end() { return {this, size_}; }
-    const_iterator begin() const { return {this, 0}; }
-    const_iterator end() const { return {this, size_}; }
-    const_iterator cbegin() const { return {this, 0};}
-    const_iterator cend() const { return {this, size_};}
+    constexpr iterator begin() { return {this, 0}; }
+    constexpr iterator end() { return {this, size_}; }
+    constexpr const_iterator begin() const { return {this, 0}; }
+    constexpr const_iterator end() const { return {this, size_}; }
+    constexpr const_iterator cbegin() const { return {this, 0};}
+    constexpr const_iterator cend() const { return {this, size_};}
 
     reverse_iterator rbegin() { return std::reverse_iterator(end()); }
     reverse_iterator rend() { return std::reverse_iterator(begin()); }
@@ -119,46 +366,677 @@ public:
     const_reverse_iterator crend() const { return std::reverse_iterator(cbegin()); }
 
 
-    [[nodiscard]] std::size_t size() const { return size_; }
-    [[nodiscard]] std::size_t capacity() const { return capacity_; }
-    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] constexpr std::size_t size() const { return size_; }
+    [[nodiscard]] constexpr std::size_t capacity() const { return capacity_; }
+    [[nodiscard]] constexpr bool empty() const { return size_ == 0; }
+
+    [[nodiscard]] constexpr MyStringView view() const {
+        return {std::string_view(smallText_.data(), std::min(size_, static_cast<std::size_t>(initialBufferSize_))),
+                bigText_};
+    }
 
-    void clear();
+    constexpr void clear();
 
     [[nodiscard]] std::string toString() const;
 
+    /// Writes both parts with ostream::write (width() and the fill character are respected).
     friend std::ostream& operator<<(std::ostream& out, const MyString& str);
 
+    /// Reads one line (like std::getline) straight into the inline buffer and the heap part.
     friend std::istream& operator>>(std::istream& in, MyString& str);
 
-    char& operator[](std::size_t index);
+    /// The rest of the stream. For a seekable stream the length is known first, so the string
+    /// is allocated once and filled by one read; other streams are read in 64 KiB chunks.
+    [[nodiscard]] static MyString readAll(std::istream& in);
 
-    const char& operator[](std::size_t index) const;
+    constexpr char& operator[](std::size_t index);
 
-    MyString& operator+=(char ch);
-    void push_back(char ch){ *this += ch; }
-    MyString& operator+=(const MyString& other);
+    constexpr const char& operator[](std::size_t index) const;
 
+    constexpr MyString& operator+=(char ch);
+    constexpr void push_back(char ch){ *this += ch; }
+    constexpr MyString& operator+=(const MyString& other);
+    constexpr MyString& append(std::string_view text);
+    constexpr MyString& append(const MyStringView& text);
 
-    bool operator==(const MyString& other) const = default;
-    std::strong_ordering operator<=>(const MyString&) const;
+    /// Appends value formatted by std::to_chars (no locale) straight into the inline buffer
+    /// or the heap part - only a number crossing the border between them goes through a stack buffer.
+    template<typename T> requires std::integral<T> && (!std::same_as<T, bool>)
+    MyString& appendNumber(T value, int base = 10) {
+        return appendChars<mystring_chars::maxLength<T>>([=](char* first, char* last) {
+            return std::to_chars(first, last, value, base);
+        });
+    }
+
+    /// The shortest representation which reads back to the same value.
+    template<std::floating_point T>
+    MyString& appendNumber(T value, std::chars_format format = std::chars_format::general) {
+        return appendChars<mystring_chars::maxLength<T>>(
+                [=](char* first, char* last) { return std::to_chars(first, last, value, format); });
+    }
+
+    /// The whole content parsed by std::from_chars (no leading whitespace or '+', no trailing characters).
+    /// Only a content longer than the inline buffer is copied, as it is not contiguous.
+    /// @return std::nullopt when the content is not a number or does not fit in T
+    template<typename T> requires (std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T>
+    [[nodiscard]] std::optional<T> parseNumber(int base = 10) const {
+        const auto parse = [base](std::string_view text) -> std::optional<T> {
+            T value{};
+            std::from_chars_result result;
+            if constexpr (std::integral<T>)
+                result = std::from_chars(text.data(), text.data() + text.size(), value, base);
+            else
+                result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (result.ec != std::errc() || result.ptr != text.data() + text.size())
+                return std::nullopt;
+            return value;
+        };
+        const MyStringView content = view();
+        return content.tail.empty() ? parse(content.head) : parse(content.toString());
+    }
+
+#if defined(__cpp_lib_format)
+    /// Appends std::format(fmt, args...). The length is measured first (std::formatted_size),
+    /// so the string grows at most once and the text is formatted straight into its buffers.
+    template<typename... Args>
+    MyString& appendFormatted(std::format_string<const Args&...> fmt, const Args&... args) {
+        const std::size_t length = std::formatted_size(fmt, args...);
+        if (size_ + length <= initialBufferSize_) {
+            std::format_to(smallText_.data() + size_, fmt, args...);
+            size_ += length;
+            if (size_ < initialBufferSize_)
+                smallText_[size_] = '\0';
+            return *this;
+        }
+
+        if constexpr (stringstats::enabled()) {
+            if (size_ <= initialBufferSize_)
+                stringstats::recordSpill();
+        }
+        const std::size_t smallCount = std::min(size_, static_cast<std::size_t>(initialBufferSize_));
+        const std::size_t bigSize = size_ + length - initialBufferSize_;
+        bigText_.resize_and_overwrite(bigSize, [&](char* big, std::size_t) {
+            std::format_to(SplitOutput(smallText_.data() + smallCount, smallText_.data() + initialBufferSize_,
+                                       big + (size_ - smallCount)), fmt, args...);
+            return bigSize;
+        });
+        size_ += length;
+        updateCapacity();
+        return *this;
+    }
+
+    /// std::format into a MyString allocated once.
+    template<typename... Args>
+    [[nodiscard]] static MyString format(std::format_string<const Args&...> fmt, const Args&... args) {
+        MyString result;
+        result.appendFormatted(fmt, args...);
+        result.recordConstruction();
+        return result;
+    }
+#endif
+
+    /// Makes room for newCapacity characters, so appending up to that size does not reallocate.
+    constexpr void reserve(std::size_t newCapacity);
+
+
+    /// Both strings are split at the same position, so the inline parts and the heap parts are compared separately.
+    constexpr bool operator==(const MyString& other) const {
+        return size_ == other.size_ && view().head == other.view().head && bigText_ == other.bigText_;
+    }
+    /// Byte-wise (as unsigned char, like std::string) lexicographical order.
+    constexpr std::strong_ordering operator<=>(const MyString&) const;
 
     [[nodiscard]] std::set<MyString> getUniqueWords() const;
     [[nodiscard]] std::map<MyString, size_t>  countWordsUsageIgnoringCases()const;
+    /// Uses a generator owned by the calling thread - see seedRandomWords() for reproducible runs.
     static MyString generateRandomWord(size_t length);
-    [[nodiscard]] bool startsWith(const MyString&) const;
-    [[nodiscard]] bool endsWith(const MyString&) const;
-    [[nodiscard]] MyString join(const std::vector<MyString> &texts) const;
+    static MyString generateRandomWord(size_t length, FastRandom& generator);
+    /// Seeds the random word generator of the calling thread.
+    static void seedRandomWords(std::uint64_t seed);
+    [[nodiscard]] std::size_t find(std::string_view pattern, std::size_t pos = 0) const;
+    [[nodiscard]] std::size_t find(const MyString& pattern, std::size_t pos = 0) const;
+    [[nodiscard]] std::size_t find(const char* pattern, std::size_t pos = 0) const {
+        return find(std::string_view(pattern), pos);
+    }
+    [[nodiscard]] std::size_t rfind(std::string_view pattern, std::size_t pos = npos) const;
+    [[nodiscard]] std::size_t rfind(const MyString& pattern, std::size_t pos = npos) const;
+    [[nodiscard]] std::size_t rfind(const char* pattern, std::size_t pos = npos) const {
+        return rfind(std::string_view(pattern), pos);
+    }
+    [[nodiscard]] bool contains(std::string_view pattern) const { return find(pattern) != npos; }
+    [[nodiscard]] bool contains(const MyString& pattern) const { return find(pattern) != npos; }
+    [[nodiscard]] bool contains(const char* pattern) const { return find(pattern) != npos; }
+    [[nodiscard]] std::size_t find_first_of(std::string_view chars, std::size_t pos = 0) const;
+    [[nodiscard]] std::size_t find_first_of(const char* chars, std::size_t pos = 0) const {
+        return find_first_of(std::string_view(chars), pos);
+    }
+    /// Start positions of all (also overlapping) occurrences of the pattern.
+    [[nodiscard]] std::vector<std::size_t> find_all(std::string_view pattern) const;
+    [[nodiscard]] std::vector<std::size_t> find_all(const char* pattern) const {
+        return find_all(std::string_view(pattern));
+    }
+
+    [[nodiscard]] constexpr bool startsWith(const MyString& txt) const {
+        return txt.size_ <= size_ && view().substr(0, txt.size_) == txt.view();
+    }
+    [[nodiscard]] constexpr bool endsWith(const MyString& txt) const {
+        return txt.size_ <= size_ && view().substr(size_ - txt.size_) == txt.view();
+    }
+    /// Any number of MyString/MyStringView/std::string/std::string_view/const char*, allocated once.
+    template<typename... Texts>
+    [[nodiscard]] static MyString concat(const Texts&... texts) {
+        const std::array<MyStringView, sizeof...(Texts)> pieces{piecesOf(texts)...};
+        return MyString(std::span<const MyStringView>(pieces));
+    }
+
+    [[nodiscard]] MyString join(const std::vector<MyString> &texts) const {
+        return join<const std::vector<MyString>&>(texts);
+    }
+
+    /// Joins any range of MyString/MyStringView/std::string/std::string_view/const char*.
+    /// For forward ranges the final length is computed first, so the result is allocated once.
+    template<std::ranges::input_range Range>
+    [[nodiscard]] MyString join(Range&& texts) const {
+        MyString result;
+        if constexpr (std::ranges::forward_range<Range>) {
+            std::size_t totalLength = 0, count = 0;
+            for (const auto& text: texts) {
+                totalLength += piecesOf(text).size();
+                ++count;
+            }
+            if (count == 0)
+                return result;
+            result.reserve(totalLength + (count - 1) * size_);
+        }
+
+        bool first = true;
+        for (auto&& text: texts) {
+            if (!first)
+                result.appendPieces(view());
+            first = false;
+            result.appendPieces(piecesOf(text));
+        }
+        result.recordConstruction();
+        return result;
+    }
+
+    /// join() for huge inputs: threads sum the lengths of their parts, a prefix sum of these sums gives
+    /// every thread its output offset and then all threads copy their pieces concurrently into the
+    /// single, already allocated result.
+    template<std::ranges::random_access_range Range>
+    requires std::ranges::sized_range<Range>
+    [[nodiscard]] MyString joinParallel(const Range& texts, unsigned threadCount = 0) const {
+        constexpr std::size_t minPiecesPerThread = 1 << 14;
+        const std::size_t count = std::ranges::size(texts);
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, count / minPiecesPerThread));
+        if (threadCount <= 1)
+            return join(texts);
+
+        const auto first = std::ranges::begin(texts);
+        const auto chunkBegin = [&](std::size_t chunk) { return count * chunk / threadCount; };
+        std::vector<std::size_t> chunkOffsets(threadCount + 1, 0);
+        {
+            std::vector<std::jthread> workers;
+            for (unsigned chunk = 0; chunk < threadCount; ++chunk) {
+                workers.emplace_back([&, chunk] {
+                    std::size_t length = 0;
+                    for (std::size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i)
+                        length += piecesOf(first[i]).size();
+                    chunkOffsets[chunk + 1] = length;
+                });
+            }
+        }
+        std::inclusive_scan(chunkOffsets.begin(), chunkOffsets.end(), chunkOffsets.begin());
+
+        const std::size_t totalLength = chunkOffsets.back() + (count - 1) * size_;
+        if (totalLength <= initialBufferSize_)
+            return join(texts);
+        MyString result;
+        result.size_ = totalLength;
+        const auto writeChunks = [&](char* big) {
+            std::vector<std::jthread> workers;
+            for (unsigned chunk = 0; chunk < threadCount; ++chunk) {
+                workers.emplace_back([&, big, chunk] {
+                    std::size_t offset = chunkOffsets[chunk] + chunkBegin(chunk) * size_;
+                    for (std::size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+                        offset = result.writeAt(offset, piecesOf(first[i]), big);
+                        if (i + 1 < count)
+                            offset = result.writeAt(offset, view(), big);
+                    }
+                });
+            }
+        };
+        // the length argument of the operation is not used - libstdc++ 12 passes the grown capacity there
+        result.bigText_.resize_and_overwrite(totalLength - initialBufferSize_, [&](char* big, std::size_t) {
+            writeChunks(big);
+            return totalLength - initialBufferSize_;
+        });
+        result.updateCapacity();
+        result.recordConstruction();
+        return result;
+    }
 
     template<typename Predicate>
     bool all_of(Predicate checker) const {
         return std::all_of(cbegin(), cend(), checker);
     }
 
-    void trim();
+    constexpr void trim();
+    /// Same bounds as trim(), but nothing is copied or modified.
+    [[nodiscard]] constexpr MyStringView trimmed() const {
+        const MyStringView text = view();
+        const auto [begin, end] = trimmedBounds(text);
+        return text.substr(begin, end - begin);
+    }
+
+    /// SSE2 kernels at run time, a plain loop during constant evaluation.
+    constexpr MyString& toLower();
+    constexpr MyString& toUpper();
+    /// ASCII-only case folding, which is the same mapping as toLower().
+    constexpr MyString& foldCase() { return toLower(); }
+
+    [[nodiscard]] MyString toLowerCopy() const;
+    /// Writes the lowercase copy into destination, reusing its heap buffer when it is large enough.
+    void toLowerCopy(MyString& destination) const;
+};
+
+
+// Members usable in constant expressions (constexpr MyString, the _ms literal) are defined here.
+// A constexpr MyString variable has to fit the inline buffer - heap memory cannot outlive constant evaluation.
+
+constexpr MyString::MyString(std::span<const MyStringView> pieces) {
+    for (const MyStringView& piece: pieces)
+        size_ += piece.size();
+    const auto writePieces = [&](char* big) {
+        std::size_t offset = 0;
+        for (const MyStringView& piece: pieces)
+            offset = writeAt(offset, piece, big);
+    };
+    if (size_ > initialBufferSize_) {
+        // the length argument of the operation is not used - libstdc++ 12 passes the grown capacity there
+        bigText_.resize_and_overwrite(size_ - initialBufferSize_, [&](char* big, std::size_t) {
+            writePieces(big);
+            return size_ - initialBufferSize_;
+        });
+    } else {
+        writePieces(nullptr);
+        if (size_ < initialBufferSize_)
+            smallText_[size_] = '\0';
+    }
+    updateCapacity();
+    recordConstruction();
+}
+
+constexpr MyString::MyString(std::size_t length, char c) {
+    if (length <= initialBufferSize_) {
+        std::fill_n(smallText_.begin(), length, c);
+        if (length < initialBufferSize_)
+            smallText_[length] = '\0';
+    } else {
+        std::ranges::fill(smallText_, c);
+        bigText_.assign(length - initialBufferSize_, c);
+    }
+    size_ = length;
+    updateCapacity();
+    recordConstruction();
+}
+
+constexpr MyString::MyString(const MyString& other)
+        : smallText_(other.smallText_), bigText_(other.bigText_), size_(other.size_) {
+    updateCapacity();
+    recordConstruction();
+}
+
+constexpr MyString& MyString::operator=(const MyString& other) {
+    if (this != &other) {
+        smallText_ = other.smallText_;
+        bigText_ = other.bigText_;
+        size_ = other.size_;
+        updateCapacity();
+    }
+    return *this;
+}
+
+constexpr MyString::MyString(MyString&& other) noexcept
+        : smallText_(other.smallText_), bigText_(std::move(other.bigText_)), capacity_(other.capacity_),
+          size_(other.size_) {
+    other.bigText_.clear();
+    other.capacity_ = initialBufferSize_ + other.bigText_.capacity();
+    other.size_ = 0;
+    other.smallText_[0] = '\0';
+}
+
+constexpr MyString& MyString::operator=(MyString&& other) noexcept {
+    if (this != &other) {
+        smallText_ = other.smallText_;
+        bigText_.swap(other.bigText_); // the old heap part of this is released or reused by other
+        capacity_ = initialBufferSize_ + bigText_.capacity();
+        size_ = other.size_;
+        other.bigText_.clear();
+        other.size_ = 0;
+        other.capacity_ = initialBufferSize_ + other.bigText_.capacity();
+        other.smallText_[0] = '\0';
+    }
+    return *this;
+}
+
+constexpr void MyString::clear() {
+    size_ = 0;
+    smallText_[0] = '\0';
+    bigText_.clear();
+}
+
+constexpr char& MyString::operator[](std::size_t index) {
+    if (index >= size_)
+        throw std::out_of_range("MyString::operator[]: invalid index");
+    return index < initialBufferSize_ ? smallText_[index] : bigText_[index - initialBufferSize_];
+}
+
+constexpr const char& MyString::operator[](std::size_t index) const {
+    if (index >= size_)
+        throw std::out_of_range("MyString::operator[]: invalid index");
+    return index < initialBufferSize_ ? smallText_[index] : bigText_[index - initialBufferSize_];
+}
+
+constexpr MyString& MyString::operator+=(char ch) {
+    if (size_ < initialBufferSize_)
+        smallText_[size_] = ch;
+    else
+        bigText_ += ch;
+
+    size_++;
+    recordSpill(size_ - 1);
+    updateCapacity();
+    if (size_ < initialBufferSize_)
+        smallText_[size_] = '\0';
+
+    return *this;
+}
+
+constexpr void MyString::appendPieces(const MyStringView& text) {
+    const std::size_t oldSize = size_;
+    for (const std::string_view piece: {text.head, text.tail}) {
+        const std::size_t smallCount = std::min(size_, static_cast<std::size_t>(initialBufferSize_));
+        const std::size_t toSmallCount = std::min(piece.size(), initialBufferSize_ - smallCount);
+        std::copy_n(piece.data(), toSmallCount, smallText_.data() + smallCount);
+        bigText_.append(piece.data() + toSmallCount, piece.size() - toSmallCount);
+        size_ += piece.size();
+    }
+
+    recordSpill(oldSize);
+    if (size_ < initialBufferSize_)
+        smallText_[size_] = '\0';
+    updateCapacity();
+}
+
+constexpr MyString& MyString::append(std::string_view text) {
+    const latency::Timer timer(latency::Operation::append);
+    appendPieces({text, {}});
+    return *this;
+}
+
+constexpr MyString& MyString::append(const MyStringView& text) {
+    const latency::Timer timer(latency::Operation::append);
+    appendPieces(text);
+    return *this;
+}
+
+constexpr void MyString::reserve(std::size_t newCapacity) {
+    if (newCapacity > initialBufferSize_)
+        bigText_.reserve(newCapacity - initialBufferSize_);
+    updateCapacity();
+}
+
+constexpr MyString& MyString::operator+=(const MyString& other) {
+    if (&other == this) {
+        const MyString copy(other);
+        return append(copy.view());
+    }
+    return append(other.view());
+}
+
+constexpr std::strong_ordering MyString::operator<=>(const MyString& other) const {
+    const latency::Timer timer(latency::Operation::compare);
+    // a head shorter than the inline buffer belongs to a string without a tail, so heads decide unless equal
+    const int heads = view().head.compare(other.view().head);
+    const int result = heads != 0 ? heads : std::string_view(bigText_).compare(other.bigText_);
+    return result <=> 0;
+}
+
+constexpr std::pair<std::size_t, std::size_t> MyString::trimmedBounds(const MyStringView& text) {
+    const auto skip = [](std::string_view piece) -> std::size_t {
+        if consteval {
+            std::size_t index = 0;
+            while (index < piece.size() && isWhitespace(piece[index]))
+                ++index;
+            return index;
+        } else {
+            return ascii::skipWhitespace(piece.data(), piece.size());
+        }
+    };
+    const auto skipBackward = [](std::string_view piece) -> std::size_t {
+        if consteval {
+            std::size_t length = piece.size();
+            while (length > 0 && isWhitespace(piece[length - 1]))
+                --length;
+            return length;
+        } else {
+            return ascii::skipWhitespaceBackward(piece.data(), piece.size());
+        }
+    };
+
+    std::size_t begin = skip(text.head);
+    if (begin == text.head.size())
+        begin += skip(text.tail);
+    if (begin == text.size())
+        return {begin, begin};
+
+    std::size_t end = skipBackward(text.tail);
+    end = end > 0 ? text.head.size() + end : skipBackward(text.head);
+    return {begin, end};
+}
+
+constexpr void MyString::trim() {
+    const latency::Timer timer(latency::Operation::trim);
+    const auto [begin, end] = trimmedBounds(view());
+    if (begin == end) {
+        clear();
+        return;
+    }
+
+    const std::size_t newSize = end - begin;
+    const std::size_t newSmallCount = std::min(newSize, static_cast<std::size_t>(initialBufferSize_));
+    if (begin > 0) {
+        //przesuniecie na początku: najpierw bufor statyczny, potem czesc dynamiczna (kopiowanie w lewo)
+        const std::size_t fromSmall = begin < initialBufferSize_
+                                      ? std::min(newSmallCount, initialBufferSize_ - begin) : 0;
+        std::copy_n(smallText_.data() + begin, fromSmall, smallText_.data());
+        if (newSmallCount > fromSmall) {
+            std::copy_n(bigText_.data() + (begin + fromSmall - initialBufferSize_), newSmallCount - fromSmall,
+                        smallText_.data() + fromSmall);
+        }
+    }
+
+    if (newSize > initialBufferSize_) {
+        bigText_.resize(end - initialBufferSize_);
+        bigText_.erase(0, begin);
+    } else {
+        bigText_.clear();
+    }
+    size_ = newSize;
+    if (size_ < initialBufferSize_)
+        smallText_[size_] = '\0';
+}
+
+constexpr MyString& MyString::toLower() {
+    const std::size_t smallCount = std::min(size_, static_cast<std::size_t>(initialBufferSize_));
+    if consteval {
+        for (char& ch: *this)
+            ch = ('A' <= ch && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+    } else {
+        ascii::toLower(smallText_.data(), smallCount);
+        ascii::toLower(bigText_.data(), bigText_.size());
+    }
+    return *this;
+}
+
+constexpr MyString& MyString::toUpper() {
+    const std::size_t smallCount = std::min(size_, static_cast<std::size_t>(initialBufferSize_));
+    if consteval {
+        for (char& ch: *this)
+            ch = ('a' <= ch && ch <= 'z') ? static_cast<char>(ch - 'a' + 'A') : ch;
+    } else {
+        ascii::toUpper(smallText_.data(), smallCount);
+        ascii::toUpper(bigText_.data(), bigText_.size());
+    }
+    return *this;
+}
+
 
-    MyString& toLower();
+namespace mystring_literals {
+
+/// "key"_ms - a MyString of the whole literal (embedded '\0' included), also in constant expressions:
+/// static_assert("key"_ms == key) and constexpr functions work. Only a constexpr variable has to be initialized
+/// with a constructor (constexpr MyString key("key");): GCC 12 rejects it initialized from a function
+/// returning an object with a std::string inside, which is what the literal operator is.
+constexpr MyString operator""_ms(const char* text, std::size_t length) {
+    return MyString(std::string_view(text, length));
+}
+
+} // namespace mystring_literals
+
+
+template<typename T>
+concept MyStringConcatOperand = std::same_as<T, MyString> || std::same_as<T, MyStringView>
+                                || std::convertible_to<const T&, std::string_view>;
+
+/// Lazy result of operator+ on MyStrings: only views of the operands are collected,
+/// and the conversion to MyString computes the total length and copies every operand once.
+/// The operands are not copied, so the expression must not outlive them - convert it
+/// within the same full-expression (MyString s = a + b + c;) rather than keeping it in an auto variable.
+template<std::size_t N>
+class MyStringConcat {
+public:
+    explicit MyStringConcat(const std::array<MyStringView, N>& pieces) : pieces_(pieces) {}
+
+    [[nodiscard]] std::size_t size() const {
+        std::size_t length = 0;
+        for (const MyStringView& piece: pieces_)
+            length += piece.size();
+        return length;
+    }
+
+    [[nodiscard]] const std::array<MyStringView, N>& pieces() const { return pieces_; }
+
+    operator MyString() const { return MyString(std::span<const MyStringView>(pieces_)); }
+
+    template<MyStringConcatOperand Text>
+    friend MyStringConcat<N + 1> operator+(const MyStringConcat& lhs, const Text& rhs) {
+        std::array<MyStringView, N + 1> pieces;
+        std::ranges::copy(lhs.pieces_, pieces.begin());
+        pieces[N] = pieceOf(rhs);
+        return MyStringConcat<N + 1>(pieces);
+    }
+
+    template<MyStringConcatOperand Text>
+    friend MyStringConcat<N + 1> operator+(const Text& lhs, const MyStringConcat& rhs) {
+        std::array<MyStringView, N + 1> pieces;
+        pieces[0] = pieceOf(lhs);
+        std::ranges::copy(rhs.pieces_, pieces.begin() + 1);
+        return MyStringConcat<N + 1>(pieces);
+    }
+
+    template<std::size_t M>
+    friend MyStringConcat<N + M> operator+(const MyStringConcat& lhs, const MyStringConcat<M>& rhs) {
+        std::array<MyStringView, N + M> pieces;
+        std::ranges::copy(rhs.pieces(), std::ranges::copy(lhs.pieces_, pieces.begin()).out);
+        return MyStringConcat<N + M>(pieces);
+    }
+
+private:
+    std::array<MyStringView, N> pieces_;
+
+    template<typename Text>
+    static MyStringView pieceOf(const Text& text) { return MyString::piecesOf(text); }
+};
+
+/// At least one operand is a MyString, so adding two C strings keeps its usual meaning.
+template<MyStringConcatOperand Lhs, MyStringConcatOperand Rhs>
+    requires std::same_as<Lhs, MyString> || std::same_as<Rhs, MyString>
+MyStringConcat<2> operator+(const Lhs& lhs, const Rhs& rhs) {
+    return MyStringConcat<0>({}) + lhs + rhs;
+}
+
+namespace mystring_hash {
+
+/// Little-endian 8-byte load written so that it is a constant expression; compilers turn it into one load.
+constexpr std::uint64_t load64(const char* data) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+        value |= std::uint64_t{static_cast<unsigned char>(data[i])} << (8 * i);
+    return value;
+}
+
+/// splitmix64 finalizer.
+constexpr std::uint64_t mix(std::uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/// 8 bytes per multiply-rotate step, then a finalizer - the same value at compile time and at run time.
+constexpr std::uint64_t hashBytes(std::string_view bytes, std::uint64_t seed) {
+    std::uint64_t state = seed ^ (bytes.size() * 0x9e3779b97f4a7c15ULL);
+    std::size_t i = 0;
+    for (; i + 8 <= bytes.size(); i += 8)
+        state = std::rotl((state ^ load64(bytes.data() + i)) * 0x9e3779b97f4a7c15ULL, 31);
+    std::uint64_t last = 0;
+    for (std::size_t shift = 0; i < bytes.size(); ++i, shift += 8)
+        last |= std::uint64_t{static_cast<unsigned char>(bytes[i])} << shift;
+    return mix(state ^ last);
+}
+
+} // namespace mystring_hash
+
+/// Hash of the content: the split into the inline and heap parts depends only on the length,
+/// so equal strings always hash the same pieces. constexpr, so hashed lookup tables can be built at compile time.
+template<>
+struct std::hash<MyString> {
+    constexpr std::size_t operator()(const MyString& text) const noexcept {
+        const latency::Timer timer(latency::Operation::hash);
+        const MyStringView pieces = text.view();
+        const std::uint64_t result = mystring_hash::hashBytes(pieces.head, 0);
+        return static_cast<std::size_t>(pieces.tail.empty() ? result : mystring_hash::hashBytes(pieces.tail, result));
+    }
+};
+
+#if defined(__cpp_lib_format)
+/// Supports the std::string_view format specification (fill, alignment, width, precision).
+/// Without a specification both parts are copied to the output; otherwise a string longer
+/// than the inline buffer is made contiguous first.
+template<>
+struct std::formatter<MyString> : std::formatter<std::string_view> {
+    constexpr auto parse(std::format_parse_context& context) {
+        plain_ = context.begin() == context.end() || *context.begin() == '}';
+        return std::formatter<std::string_view>::parse(context);
+    }
+
+    template<typename FormatContext>
+    auto format(const MyString& text, FormatContext& context) const {
+        const MyStringView pieces = text.view();
+        if (pieces.tail.empty())
+            return std::formatter<std::string_view>::format(pieces.head, context);
+        if (plain_)
+            return std::ranges::copy(pieces.tail, std::ranges::copy(pieces.head, context.out()).out).out;
+        return std::formatter<std::string_view>::format(pieces.toString(), context);
+    }
+
+private:
+    bool plain_{true};
 };
+#endif
 
 
 #endif //MYSTRING_H
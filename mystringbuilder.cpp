@@ -0,0 +1,46 @@
+#include "mystringbuilder.h"
+
+#include <algorithm>
+
+
+MyStringBuilder::MyStringBuilder(std::size_t chunkSize) : chunkSize_(std::max<std::size_t>(chunkSize, 1)) {
+}
+
+MyStringBuilder& MyStringBuilder::append(std::string_view text) {
+    while (!text.empty()) {
+        if (position_ == chunkEnd_)
+            nextChunk();
+        const std::size_t count = std::min(text.size(), static_cast<std::size_t>(chunkEnd_ - position_));
+        position_ = std::copy_n(text.data(), count, position_);
+        text.remove_prefix(count);
+    }
+    return *this;
+}
+
+void MyStringBuilder::nextChunk() {
+    if (usedChunks_ == chunks_.size())
+        chunks_.push_back(std::make_unique_for_overwrite<char[]>(chunkSize_));
+    position_ = chunks_[usedChunks_++].get();
+    chunkEnd_ = position_ + chunkSize_;
+}
+
+std::size_t MyStringBuilder::size() const {
+    if (usedChunks_ == 0)
+        return 0;
+    return (usedChunks_ - 1) * chunkSize_ + static_cast<std::size_t>(position_ - chunks_[usedChunks_ - 1].get());
+}
+
+MyString MyStringBuilder::build() const {
+    MyString result;
+    result.reserve(size());
+    for (std::size_t chunk = 0; chunk + 1 < usedChunks_; ++chunk)
+        result.append(std::string_view(chunks_[chunk].get(), chunkSize_));
+    if (usedChunks_ > 0)
+        result.append(std::string_view(chunks_[usedChunks_ - 1].get(), position_));
+    return result;
+}
+
+void MyStringBuilder::reset() {
+    usedChunks_ = 0;
+    position_ = chunkEnd_ = nullptr;
+}
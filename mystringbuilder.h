@@ -0,0 +1,96 @@
+#ifndef MYSTRINGBUILDER_H
+#define MYSTRINGBUILDER_H
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "mystring.h"
+
+
+/// Accumulates text in a chain of fixed-size chunks: appending never moves what was already written,
+/// and build() creates the MyString with one allocation of the final size.
+/// reset() keeps the chunks, so a builder reused for texts of similar length does not allocate at all.
+/// std::back_inserter(builder) is an output iterator appending to the builder.
+class MyStringBuilder {
+public:
+    using value_type = char;
+
+    static constexpr std::size_t defaultChunkSize = 4096;
+
+    explicit MyStringBuilder(std::size_t chunkSize = defaultChunkSize);
+
+    MyStringBuilder& append(char ch) {
+        if (position_ == chunkEnd_)
+            nextChunk();
+        *position_++ = ch;
+        return *this;
+    }
+    MyStringBuilder& append(std::string_view text);
+    MyStringBuilder& append(const MyStringView& text) { return append(text.head).append(text.tail); }
+    MyStringBuilder& append(const MyString& text) { return append(text.view()); }
+    MyStringBuilder& append(const char* text) { return append(std::string_view(text)); }
+
+    template<typename Text>
+    MyStringBuilder& operator+=(const Text& text) { return append(text); }
+    void push_back(char ch) { append(ch); }
+
+    /// Formatted by std::to_chars, straight into the current chunk when it has room for any value.
+    template<typename T> requires std::integral<T> && (!std::same_as<T, bool>)
+    MyStringBuilder& appendNumber(T value, int base = 10) {
+        return appendChars<mystring_chars::maxLength<T>>([=](char* first, char* last) {
+            return std::to_chars(first, last, value, base);
+        });
+    }
+
+    template<std::floating_point T>
+    MyStringBuilder& appendNumber(T value, std::chars_format format = std::chars_format::general) {
+        return appendChars<mystring_chars::maxLength<T>>(
+                [=](char* first, char* last) { return std::to_chars(first, last, value, format); });
+    }
+
+#if defined(__cpp_lib_format)
+    template<typename... Args>
+    MyStringBuilder& appendFormatted(std::format_string<const Args&...> fmt, const Args&... args) {
+        std::format_to(std::back_inserter(*this), fmt, args...);
+        return *this;
+    }
+#endif
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    /// The text appended since construction or the last reset().
+    [[nodiscard]] MyString build() const;
+
+    /// Forgets the text, but keeps the chunks for the next one.
+    void reset();
+
+    [[nodiscard]] std::size_t chunkCount() const { return chunks_.size(); }
+
+private:
+    std::size_t chunkSize_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::size_t usedChunks_{}; ///< all but the last of them are full
+    char* position_{};
+    char* chunkEnd_{};
+
+    void nextChunk();
+
+    /// A failed to_chars appends nothing.
+    template<std::size_t MaxLength, typename ToChars>
+    MyStringBuilder& appendChars(ToChars toChars) {
+        if (static_cast<std::size_t>(chunkEnd_ - position_) >= MaxLength) {
+            position_ = mystring_chars::write(position_, chunkEnd_, toChars);
+            return *this;
+        }
+        return append(mystring_chars::Buffer<MaxLength>(toChars).view());
+    }
+};
+
+
+#endif //MYSTRINGBUILDER_H
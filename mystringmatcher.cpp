@@ -0,0 +1,138 @@
+#include "mystringmatcher.h"
+
+#include <stdexcept>
+
+namespace {
+
+char lowerAscii(char ch) {
+    return ('A' <= ch && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+} // namespace
+
+
+MyStringMatcher::MyStringMatcher(const std::vector<MyString>& patterns, bool ignoreCases) {
+    buildAlphabet(patterns, ignoreCases);
+    buildTrie(patterns);
+    buildFailureTransitions();
+}
+
+void MyStringMatcher::buildAlphabet(const std::vector<MyString>& patterns, bool ignoreCases) {
+    for (const auto& pattern: patterns) {
+        for (const char ch: pattern) {
+            const auto byte = static_cast<unsigned char>(ignoreCases ? lowerAscii(ch) : ch);
+            if (byteClass_[byte] == 0)
+                byteClass_[byte] = static_cast<std::uint16_t>(classCount_++);
+        }
+    }
+    if (ignoreCases) {
+        for (char upper = 'A'; upper <= 'Z'; ++upper)
+            byteClass_[static_cast<unsigned char>(upper)] = byteClass_[static_cast<unsigned char>(lowerAscii(upper))];
+    }
+}
+
+void MyStringMatcher::buildTrie(const std::vector<MyString>& patterns) {
+    if (patterns.size() >= noPattern)
+        throw std::length_error("MyStringMatcher: too many patterns");
+    auto addState = [this] {
+        // table entries are row offsets below matchFlag, so the whole table has to fit under it
+        if (transitions_.size() + classCount_ > maxTableSize)
+            throw std::length_error("MyStringMatcher: transition table larger than 2^31 entries");
+        transitions_.resize(transitions_.size() + classCount_, 0);
+        firstPattern_.push_back(noPattern);
+        return static_cast<std::uint32_t>(firstPattern_.size() - 1);
+    };
+    addState(); // root
+
+    nextPatternInState_.assign(patterns.size(), noPattern);
+    patternLengths_.reserve(patterns.size());
+    for (std::uint32_t index = 0; index < patterns.size(); ++index) {
+        std::uint32_t state = 0;
+        for (const char ch: patterns[index]) {
+            const std::size_t edge = state * classCount_ + byteClass_[static_cast<unsigned char>(ch)];
+            if (transitions_[edge] == 0) {
+                const std::uint32_t child = addState();
+                transitions_[edge] = child; // resize in addState() does not invalidate the index
+            }
+            state = transitions_[edge];
+        }
+        patternLengths_.push_back(static_cast<std::uint32_t>(patterns[index].size()));
+        if (state != 0) {
+            nextPatternInState_[index] = firstPattern_[state];
+            firstPattern_[state] = index;
+        }
+    }
+}
+
+void MyStringMatcher::buildFailureTransitions() {
+    const std::size_t states = firstPattern_.size();
+    std::vector<std::uint32_t> failure(states, 0);
+    std::vector<std::uint32_t> matchState(states, 0);
+    std::vector<std::uint32_t> outputLink(states, 0);
+
+    // in BFS order the failure state of every state is complete before the state itself,
+    // so missing edges are copied from it, which turns the trie into a complete DFA
+    std::vector<std::uint32_t> bfsOrder{0};
+    bfsOrder.reserve(states);
+    for (std::size_t next = 0; next < bfsOrder.size(); ++next) {
+        const std::uint32_t state = bfsOrder[next];
+        const std::uint32_t fallback = failure[state];
+        if (state != 0) {
+            outputLink[state] = matchState[fallback];
+            matchState[state] = firstPattern_[state] != noPattern ? state : outputLink[state];
+        }
+
+        for (std::size_t byteClass = 0; byteClass < classCount_; ++byteClass) {
+            std::uint32_t& child = transitions_[state * classCount_ + byteClass];
+            const std::uint32_t fallbackChild = state == 0 ? 0 : transitions_[fallback * classCount_ + byteClass];
+            if (child != 0) {
+                failure[child] = fallbackChild;
+                bfsOrder.push_back(child);
+            } else {
+                child = fallbackChild;
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> newIndex(states);
+    for (std::uint32_t index = 0; index < states; ++index)
+        newIndex[bfsOrder[index]] = index;
+
+    std::vector<std::uint32_t> transitions(transitions_.size());
+    std::vector<std::uint32_t> firstPattern(states);
+    matchState_.resize(states);
+    outputLink_.resize(states);
+    for (std::uint32_t index = 0; index < states; ++index) {
+        const std::uint32_t state = bfsOrder[index];
+        for (std::size_t byteClass = 0; byteClass < classCount_; ++byteClass) {
+            const std::uint32_t target = transitions_[state * classCount_ + byteClass];
+            transitions[index * classCount_ + byteClass] = static_cast<std::uint32_t>(newIndex[target] * classCount_)
+                                                           | (matchState[target] != 0 ? matchFlag : 0);
+        }
+        firstPattern[index] = firstPattern_[state];
+        matchState_[index] = newIndex[matchState[state]];
+        outputLink_[index] = newIndex[outputLink[state]];
+    }
+    transitions_ = std::move(transitions);
+    firstPattern_ = std::move(firstPattern);
+}
+
+std::vector<MyStringMatcher::Match> MyStringMatcher::findAll(const MyString& text) const {
+    std::vector<Match> matches;
+    scan(text, [&](const Match& match) { matches.push_back(match); });
+    return matches;
+}
+
+bool MyStringMatcher::containsAny(const MyString& text) const {
+    const MyStringView content = text.view();
+    std::uint32_t row = 0;
+    for (const std::string_view piece: {content.head, content.tail}) {
+        for (const char ch: piece) {
+            const std::uint32_t entry = transitions_[row + byteClass_[static_cast<unsigned char>(ch)]];
+            if (entry & matchFlag)
+                return true;
+            row = entry;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,89 @@
+#ifndef MYSTRINGMATCHER_H
+#define MYSTRINGMATCHER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "mystring.h"
+
+
+/// Aho-Corasick automaton finding all occurrences of many patterns in one pass over the text.
+/// The automaton is a complete DFA stored as one dense table (state x byte class):
+///  - bytes are mapped to classes first, so the table has a column only for bytes occurring in the patterns,
+///  - states are numbered in BFS order, so the shallow states visited most of the time share cache lines,
+///  - an entry holds the row offset of the next state and a flag telling that some pattern ends there,
+///    so the scanning loop does one table load per byte.
+/// With ignoreCases ASCII letters are compared like in countWordsUsageIgnoringCases().
+/// Empty patterns are never reported.
+/// The table holds at most 2^31 entries (states x byte classes); a larger dictionary throws std::length_error.
+class MyStringMatcher {
+public:
+    struct Match {
+        std::size_t pattern;  ///< index of the pattern in the constructor argument
+        std::size_t position; ///< index in the text where the occurrence starts
+
+        bool operator==(const Match&) const = default;
+    };
+
+    explicit MyStringMatcher(const std::vector<MyString>& patterns, bool ignoreCases = false);
+
+    /// Calls onMatch(const Match&) for each occurrence, ordered by the end position.
+    template<typename Callback>
+    void scan(const MyStringView& text, Callback&& onMatch) const {
+        std::uint32_t row = 0;
+        std::size_t position = 0;
+        for (const std::string_view piece: {text.head, text.tail}) {
+            for (const char ch: piece) {
+                const std::uint32_t entry = transitions_[row + byteClass_[static_cast<unsigned char>(ch)]];
+                row = entry & ~matchFlag;
+                ++position;
+                if (entry & matchFlag)
+                    reportMatches(row / classCount_, position, onMatch);
+            }
+        }
+    }
+
+    template<typename Callback>
+    void scan(const MyString& text, Callback&& onMatch) const {
+        scan(text.view(), onMatch);
+    }
+
+    [[nodiscard]] std::vector<Match> findAll(const MyString& text) const;
+    [[nodiscard]] bool containsAny(const MyString& text) const;
+
+    [[nodiscard]] std::size_t patternCount() const { return patternLengths_.size(); }
+    [[nodiscard]] std::size_t stateCount() const { return matchState_.size(); }
+
+private:
+    static constexpr std::uint32_t noPattern = UINT32_MAX;
+    static constexpr std::uint32_t matchFlag = 1u << 31;
+    static constexpr std::size_t maxTableSize = matchFlag;
+
+    std::array<std::uint16_t, 256> byteClass_{}; ///< class 0: bytes absent from all patterns
+    std::size_t classCount_{1};
+    std::vector<std::uint32_t> transitions_; ///< next state * classCount_, | matchFlag when a pattern ends there
+
+    std::vector<std::uint32_t> firstPattern_;       ///< per state: pattern ending exactly in it
+    std::vector<std::uint32_t> nextPatternInState_; ///< per pattern: duplicate pattern ending in the same state
+    std::vector<std::uint32_t> matchState_;         ///< per state: itself or nearest suffix state with a pattern (0: none)
+    std::vector<std::uint32_t> outputLink_;         ///< per state: next suffix state with a pattern (0: none)
+    std::vector<std::uint32_t> patternLengths_;
+
+    void buildAlphabet(const std::vector<MyString>& patterns, bool ignoreCases);
+    void buildTrie(const std::vector<MyString>& patterns);
+    void buildFailureTransitions();
+
+    template<typename Callback>
+    void reportMatches(std::uint32_t state, std::size_t endPosition, Callback& onMatch) const {
+        for (std::uint32_t output = matchState_[state]; output != 0; output = outputLink_[output]) {
+            for (std::uint32_t pattern = firstPattern_[output]; pattern != noPattern; pattern = nextPatternInState_[pattern])
+                onMatch(Match{pattern, endPosition - patternLengths_[pattern]});
+        }
+    }
+};
+
+
+#endif //MYSTRINGMATCHER_H
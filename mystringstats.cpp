@@ -0,0 +1,169 @@
+#include "mystringstats.h"
+#include "mystring.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <numeric>
+#include <ostream>
+#include <string>
+
+namespace {
+
+struct Counters {
+    std::array<std::atomic<std::uint64_t>, stringstats::exactLengths> lengthCounts{};
+    std::atomic<std::uint64_t> longerCount{};
+    std::atomic<std::uint64_t> longerTotalLength{};
+    std::atomic<std::uint64_t> spills{};
+    std::atomic<std::uint64_t> heapAllocations{};
+    std::atomic<std::uint64_t> reallocations{};
+    std::atomic<std::uint64_t> maxLength{};
+};
+
+constinit Counters counters;
+
+void increment(std::atomic<std::uint64_t>& counter, std::uint64_t value = 1) {
+    counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+void updateMaxLength(std::uint64_t length) {
+    std::uint64_t current = counters.maxLength.load(std::memory_order_relaxed);
+    while (length > current && !counters.maxLength.compare_exchange_weak(current, length, std::memory_order_relaxed)) {
+    }
+}
+
+/// Writes the dump requested by MYSTRING_STATS_FILE when the program ends.
+struct DumpAtExit {
+    ~DumpAtExit() {
+        if (!stringstats::enabled())
+            return;
+        if (const char* path = std::getenv("MYSTRING_STATS_FILE")) {
+            std::ofstream out(path);
+            stringstats::dumpText(out);
+        }
+    }
+} dumpAtExit;
+
+} // namespace
+
+
+namespace stringstats {
+
+std::uint64_t Snapshot::constructions() const {
+    return std::accumulate(lengthCounts.begin(), lengthCounts.end(), longerCount);
+}
+
+void recordConstruction(std::size_t length) {
+    if (length < exactLengths) {
+        increment(counters.lengthCounts[length]);
+    } else {
+        increment(counters.longerCount);
+        increment(counters.longerTotalLength, length);
+    }
+    updateMaxLength(length);
+}
+
+void recordSpill() {
+    increment(counters.spills);
+}
+
+void recordHeapGrowth(std::size_t length, bool firstAllocation) {
+    increment(firstAllocation ? counters.heapAllocations : counters.reallocations);
+    updateMaxLength(length);
+}
+
+Snapshot snapshot() {
+    Snapshot stats;
+    stats.inlineCapacity = MyString::initialBufferSize_;
+    for (std::size_t length = 0; length < exactLengths; ++length)
+        stats.lengthCounts[length] = counters.lengthCounts[length].load(std::memory_order_relaxed);
+    stats.longerCount = counters.longerCount.load(std::memory_order_relaxed);
+    stats.longerTotalLength = counters.longerTotalLength.load(std::memory_order_relaxed);
+    stats.spills = counters.spills.load(std::memory_order_relaxed);
+    stats.heapAllocations = counters.heapAllocations.load(std::memory_order_relaxed);
+    stats.reallocations = counters.reallocations.load(std::memory_order_relaxed);
+    stats.maxLength = counters.maxLength.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void reset() {
+    for (auto& count: counters.lengthCounts)
+        count.store(0, std::memory_order_relaxed);
+    for (auto* counter: {&counters.longerCount, &counters.longerTotalLength, &counters.spills,
+                         &counters.heapAllocations, &counters.reallocations, &counters.maxLength})
+        counter->store(0, std::memory_order_relaxed);
+}
+
+void dumpText(std::ostream& out, const Snapshot& stats) {
+    out << "# MyString statistics\n"
+        << "inline_capacity " << stats.inlineCapacity << '\n'
+        << "constructions " << stats.constructions() << '\n'
+        << "spills " << stats.spills << '\n'
+        << "heap_allocations " << stats.heapAllocations << '\n'
+        << "reallocations " << stats.reallocations << '\n'
+        << "max_length " << stats.maxLength << '\n'
+        << "longer_count " << stats.longerCount << '\n'
+        << "longer_total_length " << stats.longerTotalLength << '\n';
+    for (std::size_t length = 0; length < exactLengths; ++length)
+        if (stats.lengthCounts[length] != 0)
+            out << "length " << length << ' ' << stats.lengthCounts[length] << '\n';
+}
+
+void dumpJson(std::ostream& out, const Snapshot& stats) {
+    out << "{\n  \"inline_capacity\": " << stats.inlineCapacity
+        << ",\n  \"constructions\": " << stats.constructions()
+        << ",\n  \"spills\": " << stats.spills
+        << ",\n  \"heap_allocations\": " << stats.heapAllocations
+        << ",\n  \"reallocations\": " << stats.reallocations
+        << ",\n  \"max_length\": " << stats.maxLength
+        << ",\n  \"longer_count\": " << stats.longerCount
+        << ",\n  \"longer_total_length\": " << stats.longerTotalLength
+        << ",\n  \"lengths\": {";
+    const char* separator = "";
+    for (std::size_t length = 0; length < exactLengths; ++length) {
+        if (stats.lengthCounts[length] != 0) {
+            out << separator << '"' << length << "\": " << stats.lengthCounts[length];
+            separator = ", ";
+        }
+    }
+    out << "}\n}\n";
+}
+
+std::optional<Snapshot> parseText(std::istream& in) {
+    Snapshot stats;
+    bool anyKey = false;
+    for (std::string key; in >> key;) {
+        if (key.starts_with('#')) {
+            std::getline(in, key);
+            continue;
+        }
+        std::uint64_t value = 0;
+        if (!(in >> value))
+            return std::nullopt;
+        anyKey = true;
+        if (key == "length") {
+            std::uint64_t count = 0;
+            if (!(in >> count) || value >= exactLengths)
+                return std::nullopt;
+            stats.lengthCounts[value] = count;
+        } else if (key == "inline_capacity") {
+            stats.inlineCapacity = value;
+        } else if (key == "spills") {
+            stats.spills = value;
+        } else if (key == "heap_allocations") {
+            stats.heapAllocations = value;
+        } else if (key == "reallocations") {
+            stats.reallocations = value;
+        } else if (key == "max_length") {
+            stats.maxLength = value;
+        } else if (key == "longer_count") {
+            stats.longerCount = value;
+        } else if (key == "longer_total_length") {
+            stats.longerTotalLength = value;
+        } // "constructions" is computed from the histogram, unknown keys are skipped
+    }
+    return anyKey ? std::optional(stats) : std::nullopt;
+}
+
+} // namespace stringstats
@@ -0,0 +1,58 @@
+#ifndef MYSTRINGSTATS_H
+#define MYSTRINGSTATS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+
+
+/// Process-wide statistics of MyString lengths and heap use, collected only in builds with
+/// MYSTRING_COLLECT_STATS defined (CMake option of the same name; always on in the tests target).
+/// Otherwise the recording functions are never called and the snapshot stays empty.
+///
+/// When the environment variable MYSTRING_STATS_FILE is set, a text dump is written there at exit;
+/// tools/inlineCapacityRecommender reads such dumps.
+namespace stringstats {
+
+inline constexpr std::size_t exactLengths = 1024; ///< longer strings share one histogram bucket
+
+struct Snapshot {
+    std::size_t inlineCapacity{};
+    std::array<std::uint64_t, exactLengths> lengthCounts{}; ///< constructions by length
+    std::uint64_t longerCount{};       ///< constructions of strings of exactLengths or more characters
+    std::uint64_t longerTotalLength{}; ///< sum of their lengths
+    std::uint64_t spills{};            ///< appends which made a string longer than the inline capacity
+    std::uint64_t heapAllocations{};   ///< first heap allocation of a string
+    std::uint64_t reallocations{};     ///< growth of an already allocated heap part
+    std::uint64_t maxLength{};         ///< seen at construction or heap growth
+
+    [[nodiscard]] std::uint64_t constructions() const;
+};
+
+[[nodiscard]] constexpr bool enabled() {
+#ifdef MYSTRING_COLLECT_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void recordConstruction(std::size_t length);
+void recordSpill();
+void recordHeapGrowth(std::size_t length, bool firstAllocation);
+
+[[nodiscard]] Snapshot snapshot();
+void reset();
+
+/// Text: "key value" lines and "length <length> <count>" lines for non-zero histogram entries.
+void dumpText(std::ostream& out, const Snapshot& stats = snapshot());
+void dumpJson(std::ostream& out, const Snapshot& stats = snapshot());
+/// Reads what dumpText() wrote.
+[[nodiscard]] std::optional<Snapshot> parseText(std::istream& in);
+
+} // namespace stringstats
+
+
+#endif //MYSTRINGSTATS_H
@@ -0,0 +1,68 @@
+#include "mystringwriter.h"
+
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
+namespace {
+
+#ifdef IOV_MAX
+constexpr std::size_t maxIovecs = IOV_MAX;
+#else
+constexpr std::size_t maxIovecs = 1024; // POSIX only guarantees 16, Linux and BSDs have 1024
+#endif
+
+} // namespace
+
+
+MyStringWriter::MyStringWriter(int fd) : fd_(fd) {
+    pending_.reserve(maxIovecs);
+}
+
+MyStringWriter::~MyStringWriter() {
+    try {
+        flush();
+    } catch (const std::system_error&) {
+    }
+}
+
+MyStringWriter& MyStringWriter::write(const MyStringView& text) {
+    push(text.head);
+    push(text.tail);
+    return *this;
+}
+
+void MyStringWriter::push(std::string_view piece) {
+    if (piece.empty())
+        return;
+    if (pending_.size() == maxIovecs)
+        flush();
+    pending_.push_back(iovec{const_cast<char*>(piece.data()), piece.size()});
+}
+
+void MyStringWriter::flush() {
+    iovec* next = pending_.data();
+    iovec* const end = next + pending_.size();
+    while (next != end) {
+        const ssize_t written = ::writev(fd_, next, static_cast<int>(end - next));
+        ++systemCalls_;
+        if (written < 0) {
+            const int error = errno;
+            if (error == EINTR)
+                continue;
+            pending_.erase(pending_.begin(), pending_.begin() + (next - pending_.data()));
+            throw std::system_error(error, std::generic_category(), "MyStringWriter: writev failed");
+        }
+        bytesWritten_ += static_cast<std::size_t>(written);
+
+        // a partial write: skip the iovecs sent completely and cut the front of the first remaining one
+        auto remaining = static_cast<std::size_t>(written);
+        while (next != end && remaining >= next->iov_len)
+            remaining -= (next++)->iov_len;
+        if (next != end) {
+            next->iov_base = static_cast<char*>(next->iov_base) + remaining;
+            next->iov_len -= remaining;
+        }
+    }
+    pending_.clear();
+}
@@ -0,0 +1,66 @@
+#ifndef MYSTRINGWRITER_H
+#define MYSTRINGWRITER_H
+
+#include <cstddef>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <sys/uio.h>
+#include <vector>
+
+#include "mystring.h"
+
+
+/// Scatter-gather output to a file descriptor: queued texts are not copied, but described by iovecs
+/// pointing at their inline and heap parts, and sent with writev() - up to IOV_MAX pieces per system call.
+/// A full batch is sent right away, so at most IOV_MAX iovecs are kept. Partial writes and EINTR are resumed, other errors throw std::system_error.
+/// The descriptor is neither owned nor closed by the writer.
+class MyStringWriter {
+public:
+    explicit MyStringWriter(int fd);
+    MyStringWriter(const MyStringWriter&) = delete;
+    MyStringWriter& operator=(const MyStringWriter&) = delete;
+    /// Flushes what is queued, errors are ignored - call flush() to see them.
+    ~MyStringWriter();
+
+    /// Queues text - it has to stay alive and unchanged until flush().
+    MyStringWriter& write(const MyStringView& text);
+    MyStringWriter& write(const MyString& text) { return write(text.view()); }
+    MyStringWriter& write(std::string_view text) { return write(MyStringView{text, {}}); }
+    MyStringWriter& write(const char* text) { return write(std::string_view(text)); }
+
+    /// Writes all elements (MyString, std::string, std::string_view, ...) with separator between them
+    /// and terminator after the last one. Everything is flushed before returning.
+    template<std::ranges::input_range Range>
+    MyStringWriter& writeAll(const Range& texts, std::string_view separator = "\n", std::string_view terminator = "\n") {
+        static_assert(std::is_lvalue_reference_v<std::ranges::range_reference_t<const Range>>,
+                      "elements are not copied, so they cannot be temporaries");
+        bool first = true;
+        for (const auto& text: texts) {
+            if (!first)
+                write(separator);
+            first = false;
+            write(text);
+        }
+        if (!first)
+            write(terminator);
+        flush();
+        return *this;
+    }
+
+    void flush();
+
+    [[nodiscard]] std::size_t bytesWritten() const { return bytesWritten_; }
+    [[nodiscard]] std::size_t systemCalls() const { return systemCalls_; }
+
+private:
+    int fd_;
+    std::vector<iovec> pending_;
+    std::size_t bytesWritten_{};
+    std::size_t systemCalls_{};
+
+    void push(std::string_view piece);
+};
+
+
+#endif //MYSTRINGWRITER_H
@@ -0,0 +1,98 @@
+#include "packedword.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "wordtokenizer.h"
+
+
+PackedWord::PackedWord(const MyStringView& text) {
+    if (const auto letters = PackedLetters::pack(text))
+        storage_ = *letters;
+    else
+        storage_ = MyString(text);
+}
+
+PackedWord::PackedWord(MyString text) {
+    if (const auto letters = PackedLetters::pack(text.view()))
+        storage_ = *letters;
+    else
+        storage_ = std::move(text);
+}
+
+std::size_t PackedWord::size() const {
+    if (const PackedLetters* letters = packed())
+        return letters->size();
+    return std::get<MyString>(storage_).size();
+}
+
+char PackedWord::operator[](std::size_t index) const {
+    if (const PackedLetters* letters = packed()) {
+        if (index >= letters->size())
+            throw std::out_of_range("PackedWord::operator[]: invalid index");
+        return (*letters)[index];
+    }
+    return std::get<MyString>(storage_)[index];
+}
+
+MyString PackedWord::toMyString() const {
+    if (const PackedLetters* letters = packed())
+        return letters->toMyString();
+    return std::get<MyString>(storage_);
+}
+
+std::strong_ordering PackedWord::compareUnpacked(const PackedWord& lhs, const PackedWord& rhs) {
+    const PackedLetters* lhsLetters = lhs.packed();
+    const PackedLetters* rhsLetters = rhs.packed();
+    if (!lhsLetters && !rhsLetters)
+        return std::get<MyString>(lhs.storage_) <=> std::get<MyString>(rhs.storage_);
+
+    // only one side is packed: its letters are unpacked to the stack and compared with the MyString
+    std::array<char, PackedLetters::maxLength> letters;
+    const std::size_t length = (lhsLetters ? lhsLetters : rhsLetters)->unpack(letters.data());
+    const MyString& text = std::get<MyString>((lhsLetters ? rhs : lhs).storage_);
+    const std::strong_ordering packedFirst = std::lexicographical_compare_three_way(
+            letters.begin(), letters.begin() + static_cast<std::ptrdiff_t>(length), text.begin(), text.end(),
+            [](char a, char b) { return static_cast<unsigned char>(a) <=> static_cast<unsigned char>(b); });
+    return lhsLetters ? packedFirst : 0 <=> packedFirst;
+}
+
+std::ostream& operator<<(std::ostream& out, const PackedWord& word) {
+    if (const PackedLetters* letters = word.packed()) {
+        std::array<char, PackedLetters::maxLength> buffer;
+        return out << std::string_view(buffer.data(), letters->unpack(buffer.data()));
+    }
+    return out << std::get<MyString>(word.storage_);
+}
+
+namespace packedwords {
+
+namespace {
+/// Lowercase word as a key: packed straight from the text, or a lowercased MyString for longer words.
+PackedWord lowercaseWord(std::string_view word) {
+    if (const auto letters = PackedLetters::packIgnoringCase(word))
+        return *letters;
+    MyString lowerWord(word);
+    lowerWord.toLower();
+    return PackedWord(std::move(lowerWord));
+}
+} // namespace
+
+std::set<PackedWord> getUniqueWords(const MyString& text) {
+    std::set<PackedWord> uniqueWords;
+    forEachWord<charclass::letters>(text, [&](std::string_view word) {
+        uniqueWords.insert(lowercaseWord(word));
+    });
+    return uniqueWords;
+}
+
+std::map<PackedWord, std::size_t> countWordsUsageIgnoringCases(const MyString& text) {
+    std::map<PackedWord, std::size_t> wordCounter;
+    forEachWord<charclass::letters>(text, [&](std::string_view word) {
+        ++wordCounter[lowercaseWord(word)];
+    });
+    return wordCounter;
+}
+
+} // namespace packedwords
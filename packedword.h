@@ -0,0 +1,192 @@
+#ifndef PACKEDWORD_H
+#define PACKEDWORD_H
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include "mystring.h"
+
+
+/// Up to 32 letters a-z in 20 bytes, 5 bits each: codes 1-26, 0 after the last letter.
+/// The first letter takes the highest bits of the 160-bit number kept in bits_ (most significant word first),
+/// so comparing the numbers compares the words lexicographically, and a prefix is smaller than the word.
+class PackedLetters {
+public:
+    static constexpr std::size_t maxLength = 32;
+
+    constexpr PackedLetters() = default;
+
+    /// std::nullopt for text longer than maxLength or with characters other than a-z.
+    static constexpr std::optional<PackedLetters> pack(const MyStringView& text) { return pack<false>(text); }
+    static constexpr std::optional<PackedLetters> pack(std::string_view text) { return pack<false>({text, {}}); }
+    /// A-Z are packed as a-z.
+    static constexpr std::optional<PackedLetters> packIgnoringCase(std::string_view text) {
+        return pack<true>({text, {}});
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const {
+        for (std::size_t word = bits_.size(); word > 0; --word) {
+            if (bits_[word - 1] != 0) {
+                const std::size_t usedBits = 32 * word - static_cast<std::size_t>(std::countr_zero(bits_[word - 1]));
+                return (usedBits + bitsPerLetter - 1) / bitsPerLetter;
+            }
+        }
+        return 0;
+    }
+    [[nodiscard]] constexpr bool empty() const { return bits_[0] == 0; }
+
+    /// Unpacked letter (no range check, index < size()).
+    [[nodiscard]] constexpr char operator[](std::size_t index) const {
+        const auto [word, shift] = position(index);
+        return static_cast<char>('a' - 1 + ((window(word) >> shift) & letterMask));
+    }
+
+    /// Writes size() letters to destination, which needs room for maxLength.
+    constexpr std::size_t unpack(char* destination) const {
+        const std::size_t length = size();
+        for (std::size_t i = 0; i < length; ++i)
+            destination[i] = (*this)[i];
+        return length;
+    }
+
+    [[nodiscard]] MyString toMyString() const {
+        std::array<char, maxLength> letters;
+        return MyString(std::string_view(letters.data(), unpack(letters.data())));
+    }
+
+    [[nodiscard]] constexpr const std::array<std::uint32_t, 5>& bits() const { return bits_; }
+
+    friend constexpr bool operator==(const PackedLetters&, const PackedLetters&) = default;
+    /// Three integer comparisons: 64, 64 and 32 bits of the packed number.
+    friend constexpr std::strong_ordering operator<=>(const PackedLetters& lhs, const PackedLetters& rhs) {
+        if (lhs.window(0) != rhs.window(0))
+            return lhs.window(0) <=> rhs.window(0);
+        if (lhs.window(2) != rhs.window(2))
+            return lhs.window(2) <=> rhs.window(2);
+        return lhs.bits_[4] <=> rhs.bits_[4];
+    }
+
+private:
+    static constexpr std::size_t bitsPerLetter = 5;
+    static constexpr std::uint64_t letterMask = 0x1f;
+
+    std::array<std::uint32_t, 5> bits_{};
+
+    /// Word holding the highest bit of the letter and the shift of the letter in window(word).
+    static constexpr std::pair<std::size_t, int> position(std::size_t index) {
+        const std::size_t bit = index * bitsPerLetter;
+        return {bit / 32, static_cast<int>(64 - bit % 32 - bitsPerLetter)};
+    }
+
+    /// bits_[word] and the next word as one 64-bit number, so a letter crossing words is read in one step.
+    [[nodiscard]] constexpr std::uint64_t window(std::size_t word) const {
+        const std::uint64_t next = word + 1 < bits_.size() ? bits_[word + 1] : 0;
+        return (std::uint64_t{bits_[word]} << 32) | next;
+    }
+
+    template<bool IgnoreCase>
+    static constexpr std::optional<PackedLetters> pack(const MyStringView& text) {
+        if (text.size() > maxLength)
+            return std::nullopt;
+        // letters are shifted into pending, which gives away its highest 32 bits whenever it has them
+        PackedLetters result;
+        std::size_t word = 0;
+        std::uint64_t pending = 0;
+        int pendingBits = 0;
+        for (const std::string_view piece: {text.head, text.tail}) {
+            for (char ch: piece) {
+                if (IgnoreCase && 'A' <= ch && ch <= 'Z')
+                    ch = static_cast<char>(ch - 'A' + 'a');
+                if (ch < 'a' || ch > 'z')
+                    return std::nullopt;
+                pending = (pending << bitsPerLetter) | static_cast<std::uint64_t>(ch - 'a' + 1);
+                pendingBits += static_cast<int>(bitsPerLetter);
+                if (pendingBits >= 32) {
+                    pendingBits -= 32;
+                    result.bits_[word++] = static_cast<std::uint32_t>(pending >> pendingBits);
+                    pending &= (std::uint64_t{1} << pendingBits) - 1;
+                }
+            }
+        }
+        if (pendingBits > 0)
+            result.bits_[word] = static_cast<std::uint32_t>(pending << (32 - pendingBits));
+        return result;
+    }
+};
+
+/// A word kept as PackedLetters when it has up to 32 letters a-z (no heap allocation, comparisons on
+/// the packed numbers), and as a MyString otherwise. Every text that can be packed is packed,
+/// so equal words always have the same representation. Characters are returned by value.
+class PackedWord {
+public:
+    PackedWord() = default;
+    PackedWord(const PackedLetters& letters) : storage_(letters) {}
+    explicit PackedWord(const char* text) : PackedWord(std::string_view(text)) {}
+    explicit PackedWord(std::string_view text) : PackedWord(MyStringView{text, {}}) {}
+    explicit PackedWord(const MyStringView& text);
+    explicit PackedWord(MyString text);
+
+    [[nodiscard]] bool isPacked() const { return std::holds_alternative<PackedLetters>(storage_); }
+    /// nullptr for a word kept as a MyString.
+    [[nodiscard]] const PackedLetters* packed() const { return std::get_if<PackedLetters>(&storage_); }
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    /// Unpacked character, std::out_of_range for an invalid index.
+    [[nodiscard]] char operator[](std::size_t index) const;
+
+    [[nodiscard]] MyString toMyString() const;
+
+    friend bool operator==(const PackedWord& lhs, const PackedWord& rhs) { return lhs.storage_ == rhs.storage_; }
+    /// Lexicographic, unsigned byte order like MyString; two packed words compare their packed numbers.
+    friend std::strong_ordering operator<=>(const PackedWord& lhs, const PackedWord& rhs) {
+        const PackedLetters* lhsLetters = lhs.packed();
+        const PackedLetters* rhsLetters = rhs.packed();
+        return lhsLetters && rhsLetters ? *lhsLetters <=> *rhsLetters : compareUnpacked(lhs, rhs);
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const PackedWord& word);
+
+private:
+    std::variant<PackedLetters, MyString> storage_;
+
+    static std::strong_ordering compareUnpacked(const PackedWord& lhs, const PackedWord& rhs);
+
+    friend struct std::hash<PackedWord>;
+};
+
+template<>
+struct std::hash<PackedWord> {
+    std::size_t operator()(const PackedWord& word) const noexcept {
+        if (const PackedLetters* letters = word.packed()) {
+            std::uint64_t result = 0;
+            for (const std::uint32_t bits: letters->bits())
+                result = mystring_hash::mix(result ^ bits);
+            return static_cast<std::size_t>(result);
+        }
+        return std::hash<MyString>{}(std::get<MyString>(word.storage_));
+    }
+};
+
+/// MyString::getUniqueWords() and countWordsUsageIgnoringCases() with PackedWord keys:
+/// words up to 32 letters are lowercased while packing and never allocate.
+namespace packedwords {
+
+[[nodiscard]] std::set<PackedWord> getUniqueWords(const MyString& text);
+[[nodiscard]] std::map<PackedWord, std::size_t> countWordsUsageIgnoringCases(const MyString& text);
+
+} // namespace packedwords
+
+
+#endif //PACKEDWORD_H
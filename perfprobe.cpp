@@ -0,0 +1,166 @@
+#include "perfprobe.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+PerfReading& PerfReading::operator+=(const PerfReading& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cacheMisses += other.cacheMisses;
+    branchMisses += other.branchMisses;
+    taskClockNs += other.taskClockNs;
+    return *this;
+}
+
+PerfReading PerfReading::operator-(const PerfReading& earlier) const {
+    return {cycles - earlier.cycles, instructions - earlier.instructions, cacheMisses - earlier.cacheMisses,
+            branchMisses - earlier.branchMisses, taskClockNs - earlier.taskClockNs};
+}
+
+double PerfReading::instructionsPerCycle() const {
+    return cycles == 0 ? 0.0 : static_cast<double>(instructions) / static_cast<double>(cycles);
+}
+
+
+#if defined(__linux__)
+
+namespace {
+
+int openEvent(std::uint32_t type, std::uint64_t config, int groupLeader) {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.exclude_kernel = 1; // allowed with perf_event_paranoid <= 2
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, groupLeader, 0));
+}
+
+/// Hardware events in one group (read together, scheduled together) and task-clock on its own.
+class ThreadCounters {
+public:
+    ThreadCounters() {
+        constexpr std::array<std::uint64_t, hardwareEvents> configs{
+                PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (std::size_t event = 0; event < hardwareEvents; ++event) {
+            const int fd = openEvent(PERF_TYPE_HARDWARE, configs[event], event == 0 ? -1 : hardware_[0]);
+            if (fd < 0) {
+                unavailableReason_ = std::string("perf_event_open: ") + std::strerror(errno);
+                closeHardware();
+                break;
+            }
+            hardware_[event] = fd;
+        }
+        taskClock_ = openEvent(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, -1);
+    }
+
+    ~ThreadCounters() {
+        closeHardware();
+        if (taskClock_ >= 0)
+            close(taskClock_);
+    }
+
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+    [[nodiscard]] bool hardwareAvailable() const { return hardware_[0] >= 0; }
+    [[nodiscard]] bool softwareAvailable() const { return taskClock_ >= 0; }
+    [[nodiscard]] const std::string& unavailableReason() const { return unavailableReason_; }
+
+    [[nodiscard]] PerfReading read() const {
+        PerfReading reading;
+        if (hardwareAvailable()) {
+            const auto values = readGroup(hardware_[0]);
+            reading.cycles = values[0];
+            reading.instructions = values[1];
+            reading.cacheMisses = values[2];
+            reading.branchMisses = values[3];
+        }
+        if (softwareAvailable())
+            reading.taskClockNs = readGroup(taskClock_)[0];
+        return reading;
+    }
+
+private:
+    static constexpr std::size_t hardwareEvents = 4;
+
+    std::array<int, hardwareEvents> hardware_{-1, -1, -1, -1};
+    int taskClock_{-1};
+    std::string unavailableReason_;
+
+    void closeHardware() {
+        for (int& fd: hardware_) {
+            if (fd >= 0)
+                close(fd);
+            fd = -1;
+        }
+    }
+
+    /// Values of the group led by leader, scaled by enabled / running time when the events were multiplexed.
+    static std::array<std::uint64_t, hardwareEvents> readGroup(int leader) {
+        struct {
+            std::uint64_t count;
+            std::uint64_t timeEnabled;
+            std::uint64_t timeRunning;
+            std::array<std::uint64_t, hardwareEvents> values;
+        } buffer{};
+        std::array<std::uint64_t, hardwareEvents> result{};
+        if (::read(leader, &buffer, sizeof(buffer)) <= 0 || buffer.timeRunning == 0)
+            return result;
+        const double scale = static_cast<double>(buffer.timeEnabled) / static_cast<double>(buffer.timeRunning);
+        for (std::size_t event = 0; event < buffer.count && event < hardwareEvents; ++event)
+            result[event] = static_cast<std::uint64_t>(static_cast<double>(buffer.values[event]) * scale);
+        return result;
+    }
+};
+
+const ThreadCounters& threadCounters() {
+    thread_local const ThreadCounters counters;
+    return counters;
+}
+
+} // namespace
+
+bool PerfCounters::hardwareAvailable() {
+    return threadCounters().hardwareAvailable();
+}
+
+bool PerfCounters::softwareAvailable() {
+    return threadCounters().softwareAvailable();
+}
+
+std::string PerfCounters::unavailableReason() {
+    return threadCounters().unavailableReason();
+}
+
+PerfReading PerfCounters::read() {
+    return threadCounters().read();
+}
+
+#else
+
+bool PerfCounters::hardwareAvailable() {
+    return false;
+}
+
+bool PerfCounters::softwareAvailable() {
+    return false;
+}
+
+std::string PerfCounters::unavailableReason() {
+    return "perf_event_open is available only on Linux";
+}
+
+PerfReading PerfCounters::read() {
+    return {};
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef PERFPROBE_H
+#define PERFPROBE_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+
+/// Values of the counters of the calling thread (user space only).
+struct PerfReading {
+    std::uint64_t cycles{};
+    std::uint64_t instructions{};
+    std::uint64_t cacheMisses{};
+    std::uint64_t branchMisses{};
+    std::uint64_t taskClockNs{}; ///< software counter - available also where the hardware ones are not
+
+    PerfReading& operator+=(const PerfReading& other);
+    [[nodiscard]] PerfReading operator-(const PerfReading& earlier) const;
+    [[nodiscard]] double instructionsPerCycle() const;
+};
+
+/// Counters of the calling thread opened with perf_event_open once per thread and kept running,
+/// so a reading costs two read() system calls (~1 us) - wrap operations taking at least microseconds,
+/// or a loop of many calls, and divide. Hardware counters are scaled when the kernel multiplexes them.
+///
+/// Graceful fallback: where the hardware counters cannot be opened (not Linux, perf_event_paranoid,
+/// virtual machine, container without the syscall) they read 0 and hardwareAvailable() is false;
+/// task-clock still works when only the software events are allowed.
+class PerfCounters {
+public:
+    [[nodiscard]] static bool hardwareAvailable();
+    [[nodiscard]] static bool softwareAvailable();
+    /// Why the hardware counters are not available, empty when they are.
+    [[nodiscard]] static std::string unavailableReason();
+
+    [[nodiscard]] static PerfReading read();
+};
+
+/// Adds what the counters of the calling thread counted during its lifetime to target:
+///     PerfReading insertCost;
+///     { PerfProbe probe(insertCost); wordCounter[word]++; }
+class PerfProbe {
+public:
+    explicit PerfProbe(PerfReading& target) : target_(target), start_(PerfCounters::read()) {}
+    ~PerfProbe() { target_ += PerfCounters::read() - start_; }
+
+    PerfProbe(const PerfProbe&) = delete;
+    PerfProbe& operator=(const PerfProbe&) = delete;
+
+private:
+    PerfReading& target_;
+    PerfReading start_;
+};
+
+
+#endif //PERFPROBE_H
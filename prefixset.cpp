@@ -0,0 +1,69 @@
+#include "prefixset.h"
+
+#include <algorithm>
+
+PrefixSet::PrefixSet(const std::vector<MyString>& strings) : size_(strings.size()) {
+    prefixes_.build(strings, false);
+    suffixes_.build(strings, true);
+
+    const auto empty = std::ranges::find_if(strings, &MyString::empty);
+    if (empty != strings.end())
+        emptyString_ = static_cast<std::size_t>(empty - strings.begin());
+}
+
+void PrefixSet::Trie::build(const std::vector<MyString>& strings, bool reversed) {
+    for (const auto& text: strings)
+        for (const char ch: text)
+            if (byteClass[static_cast<unsigned char>(ch)] == 0)
+                byteClass[static_cast<unsigned char>(ch)] = static_cast<std::uint16_t>(classCount++);
+
+    children.assign(classCount, 0);
+    stringEndingHere.assign(1, noString);
+    for (std::uint32_t index = 0; index < strings.size(); ++index) {
+        std::uint32_t node = 0;
+        const auto descend = [&](char ch) {
+            const std::size_t edge = node * classCount + byteClass[static_cast<unsigned char>(ch)];
+            if (children[edge] == 0) {
+                children[edge] = static_cast<std::uint32_t>(stringEndingHere.size());
+                children.resize(children.size() + classCount, 0);
+                stringEndingHere.push_back(noString);
+            }
+            node = children[edge];
+        };
+        if (reversed)
+            std::for_each(strings[index].rbegin(), strings[index].rend(), descend);
+        else
+            std::for_each(strings[index].begin(), strings[index].end(), descend);
+
+        if (node != 0 && stringEndingHere[node] == noString)
+            stringEndingHere[node] = index;
+    }
+}
+
+std::size_t PrefixSet::longestPrefixOf(const MyStringView& key) const {
+    std::size_t longest = emptyString_;
+    prefixes_.walk(key, false, [&](std::size_t index) { longest = index; });
+    return longest;
+}
+
+std::vector<std::size_t> PrefixSet::allPrefixesOf(const MyStringView& key) const {
+    std::vector<std::size_t> found;
+    if (emptyString_ != npos)
+        found.push_back(emptyString_);
+    prefixes_.walk(key, false, [&](std::size_t index) { found.push_back(index); });
+    return found;
+}
+
+std::size_t PrefixSet::longestSuffixOf(const MyStringView& key) const {
+    std::size_t longest = emptyString_;
+    suffixes_.walk(key, true, [&](std::size_t index) { longest = index; });
+    return longest;
+}
+
+std::vector<std::size_t> PrefixSet::allSuffixesOf(const MyStringView& key) const {
+    std::vector<std::size_t> found;
+    if (emptyString_ != npos)
+        found.push_back(emptyString_);
+    suffixes_.walk(key, true, [&](std::size_t index) { found.push_back(index); });
+    return found;
+}
@@ -0,0 +1,79 @@
+#ifndef PREFIXSET_H
+#define PREFIXSET_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "mystring.h"
+
+
+/// Set of strings compiled into two tries (over the strings and over their reversals),
+/// answering prefix/suffix queries for a key in one walk - O(key length), whatever the number of strings.
+/// Results are indices into the constructor argument; for duplicated strings the first index is used.
+class PrefixSet {
+public:
+    static constexpr std::size_t npos = std::string_view::npos;
+
+    explicit PrefixSet(const std::vector<MyString>& strings);
+
+    [[nodiscard]] std::size_t longestPrefixOf(const MyStringView& key) const;
+    [[nodiscard]] std::size_t longestPrefixOf(const MyString& key) const { return longestPrefixOf(key.view()); }
+    /// Ordered from the shortest to the longest.
+    [[nodiscard]] std::vector<std::size_t> allPrefixesOf(const MyStringView& key) const;
+    [[nodiscard]] std::vector<std::size_t> allPrefixesOf(const MyString& key) const { return allPrefixesOf(key.view()); }
+
+    [[nodiscard]] std::size_t longestSuffixOf(const MyStringView& key) const;
+    [[nodiscard]] std::size_t longestSuffixOf(const MyString& key) const { return longestSuffixOf(key.view()); }
+    /// Ordered from the shortest to the longest.
+    [[nodiscard]] std::vector<std::size_t> allSuffixesOf(const MyStringView& key) const;
+    [[nodiscard]] std::vector<std::size_t> allSuffixesOf(const MyString& key) const { return allSuffixesOf(key.view()); }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+    /// Dense trie: node x byte class table, bytes absent from all strings share class 0 which has no children.
+    struct Trie {
+        static constexpr std::uint32_t noString = UINT32_MAX;
+
+        std::array<std::uint16_t, 256> byteClass{};
+        std::size_t classCount{1};
+        std::vector<std::uint32_t> children;
+        std::vector<std::uint32_t> stringEndingHere;
+
+        void build(const std::vector<MyString>& strings, bool reversed);
+
+        /// Calls onString(index) for every string on the path spelled by the key, shortest first.
+        template<typename Callback>
+        void walk(const MyStringView& key, bool reversed, Callback&& onString) const {
+            std::uint32_t node = 0;
+            const auto step = [&](char ch) {
+                node = children[node * classCount + byteClass[static_cast<unsigned char>(ch)]];
+                if (node != 0 && stringEndingHere[node] != noString)
+                    onString(stringEndingHere[node]);
+                return node != 0;
+            };
+            if (!reversed) {
+                for (const char ch: key.head)
+                    if (!step(ch)) return;
+                for (const char ch: key.tail)
+                    if (!step(ch)) return;
+            } else {
+                for (auto it = key.tail.rbegin(); it != key.tail.rend(); ++it)
+                    if (!step(*it)) return;
+                for (auto it = key.head.rbegin(); it != key.head.rend(); ++it)
+                    if (!step(*it)) return;
+            }
+        }
+    };
+
+    Trie prefixes_;
+    Trie suffixes_;
+    std::size_t size_;
+    std::size_t emptyString_{npos};
+};
+
+
+#endif //PREFIXSET_H
@@ -0,0 +1,282 @@
+#include "stringsearch.h"
+#include "wordtokenizer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr std::size_t noPosition = SubstringSearcher::npos;
+
+unsigned char byteAt(std::string_view text, std::size_t index) {
+    return static_cast<unsigned char>(text[index]);
+}
+
+/// Crochemore-Perrin critical factorization: the later of the two maximal suffixes
+/// (for both byte orderings) splits the pattern so that the local period equals the global one.
+std::size_t criticalFactorization(std::string_view pattern, std::size_t& period) {
+    const std::size_t length = pattern.size();
+
+    // indices start at "-1" (wrap-around of size_t) as in the original description of the algorithm
+    std::size_t maxSuffix = noPosition;
+    std::size_t j = 0, k = 1, p = 1;
+    while (j + k < length) {
+        const unsigned char a = byteAt(pattern, j + k);
+        const unsigned char b = byteAt(pattern, maxSuffix + k);
+        if (a < b) {
+            j += k;
+            k = 1;
+            p = j - maxSuffix;
+        } else if (a == b) {
+            if (k != p) {
+                ++k;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            maxSuffix = j++;
+            k = p = 1;
+        }
+    }
+    period = p;
+
+    std::size_t maxSuffixReversed = noPosition;
+    j = 0, k = 1, p = 1;
+    while (j + k < length) {
+        const unsigned char a = byteAt(pattern, j + k);
+        const unsigned char b = byteAt(pattern, maxSuffixReversed + k);
+        if (b < a) {
+            j += k;
+            k = 1;
+            p = j - maxSuffixReversed;
+        } else if (a == b) {
+            if (k != p) {
+                ++k;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            maxSuffixReversed = j++;
+            k = p = 1;
+        }
+    }
+
+    if (maxSuffixReversed + 1 < maxSuffix + 1)
+        return maxSuffix + 1;
+    period = p;
+    return maxSuffixReversed + 1;
+}
+
+std::size_t findShortPattern(const char* text, std::size_t length, std::string_view pattern) {
+    const std::size_t patternLength = pattern.size();
+    const char first = pattern.front();
+    const char last = pattern.back();
+
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i firstBytes = _mm_set1_epi8(first);
+    const __m128i lastBytes = _mm_set1_epi8(last);
+    for (; i + patternLength - 1 + 16 <= length; i += 16) {
+        const __m128i firstMatches = _mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)), firstBytes);
+        const __m128i lastMatches = _mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + patternLength - 1)), lastBytes);
+        auto candidates = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(firstMatches, lastMatches)));
+        while (candidates != 0) {
+            const std::size_t candidate = i + std::countr_zero(candidates);
+            if (std::memcmp(text + candidate + 1, pattern.data() + 1, patternLength - 2) == 0)
+                return candidate;
+            candidates &= candidates - 1;
+        }
+    }
+#endif
+    for (; i + patternLength <= length; ++i) {
+        if (text[i] == first && text[i + patternLength - 1] == last
+            && std::memcmp(text + i + 1, pattern.data() + 1, patternLength - 2) == 0)
+            return i;
+    }
+    return noPosition;
+}
+
+/// @return true when pattern occurs at position start of the two-piece text (start < head.size())
+bool matchesAcrossBorder(const MyStringView& text, std::string_view pattern, std::size_t start) {
+    const std::size_t inHead = text.head.size() - start;
+    return pattern.size() - inHead <= text.tail.size()
+           && text.head.substr(start) == pattern.substr(0, inHead)
+           && text.tail.substr(0, pattern.size() - inHead) == pattern.substr(inHead);
+}
+
+} // namespace
+
+
+SubstringSearcher::SubstringSearcher(std::string_view pattern) : pattern_(pattern) {
+    if (pattern_.size() <= shortPatternLength_)
+        return;
+
+    criticalPosition_ = criticalFactorization(pattern_, period_);
+    periodic_ = pattern_.compare(0, criticalPosition_, pattern_, period_, criticalPosition_) == 0;
+    if (!periodic_)
+        period_ = std::max(criticalPosition_, pattern_.size() - criticalPosition_) + 1;
+
+    shift_.fill(pattern_.size());
+    for (std::size_t i = 0; i < pattern_.size(); ++i)
+        shift_[byteAt(pattern_, i)] = pattern_.size() - i - 1;
+}
+
+std::size_t SubstringSearcher::find(std::string_view text, std::size_t pos) const {
+    if (pos > text.size())
+        return npos;
+    const std::size_t patternLength = pattern_.size();
+    if (patternLength == 0)
+        return pos;
+    if (patternLength > text.size() - pos)
+        return npos;
+
+    const char* const begin = text.data() + pos;
+    const std::size_t length = text.size() - pos;
+    std::size_t found;
+    if (patternLength == 1) {
+        const void* match = std::memchr(begin, pattern_.front(), length);
+        found = match ? static_cast<const char*>(match) - begin : npos;
+    } else if (patternLength <= shortPatternLength_) {
+        found = findShortPattern(begin, length, pattern_);
+    } else {
+        found = findTwoWay(std::string_view(begin, length));
+    }
+    return found == npos ? npos : pos + found;
+}
+
+std::size_t SubstringSearcher::find(const MyStringView& text, std::size_t pos) const {
+    const std::size_t headSize = text.head.size();
+    const std::size_t patternLength = pattern_.size();
+    if (pos > text.size())
+        return npos;
+    if (pos < headSize) {
+        if (const std::size_t found = find(text.head, pos); found != npos)
+            return found;
+        if (patternLength > 0 && !text.tail.empty()) {
+            const std::size_t firstCrossing = headSize >= patternLength ? headSize - patternLength + 1 : 0;
+            for (std::size_t start = std::max(pos, firstCrossing); start < headSize; ++start)
+                if (matchesAcrossBorder(text, pattern_, start))
+                    return start;
+        }
+    }
+    const std::size_t found = find(text.tail, pos > headSize ? pos - headSize : 0);
+    return found == npos ? npos : headSize + found;
+}
+
+std::size_t SubstringSearcher::findTwoWay(std::string_view text) const {
+    const std::size_t patternLength = pattern_.size();
+    const std::size_t length = text.size();
+    const std::size_t lastIndex = patternLength - 1;
+
+    std::size_t j = 0;
+    if (periodic_) {
+        // the prefix of length period_ which already matched does not need to be compared again
+        std::size_t memory = 0;
+        while (j <= length - patternLength) {
+            std::size_t shift = shift_[byteAt(text, j + lastIndex)];
+            if (shift > 0) {
+                if (memory != 0 && shift < period_)
+                    shift = patternLength - period_;
+                memory = 0;
+                j += shift;
+                continue;
+            }
+            std::size_t i = std::max(criticalPosition_, memory);
+            while (i < lastIndex && pattern_[i] == text[i + j])
+                ++i;
+            if (i >= lastIndex) {
+                i = criticalPosition_ - 1;
+                while (memory < i + 1 && pattern_[i] == text[i + j])
+                    --i;
+                if (i + 1 < memory + 1)
+                    return j;
+                j += period_;
+                memory = patternLength - period_;
+            } else {
+                j += i - criticalPosition_ + 1;
+                memory = 0;
+            }
+        }
+    } else {
+        while (j <= length - patternLength) {
+            const std::size_t shift = shift_[byteAt(text, j + lastIndex)];
+            if (shift > 0) {
+                j += shift;
+                continue;
+            }
+            std::size_t i = criticalPosition_;
+            while (i < lastIndex && pattern_[i] == text[i + j])
+                ++i;
+            if (i >= lastIndex) {
+                i = criticalPosition_ - 1;
+                while (i != npos && pattern_[i] == text[i + j])
+                    --i;
+                if (i == npos)
+                    return j;
+                j += period_;
+            } else {
+                j += i - criticalPosition_ + 1;
+            }
+        }
+    }
+    return npos;
+}
+
+
+namespace search {
+
+std::size_t find(const MyStringView& text, std::string_view pattern, std::size_t pos) {
+    return SubstringSearcher(pattern).find(text, pos);
+}
+
+std::size_t rfind(const MyStringView& text, std::string_view pattern, std::size_t pos) {
+    const std::size_t headSize = text.head.size();
+    if (pattern.size() > text.size())
+        return npos;
+    const std::size_t lastStart = std::min(pos, text.size() - pattern.size());
+
+    if (lastStart >= headSize) {
+        if (const std::size_t found = text.tail.rfind(pattern, lastStart - headSize); found != npos)
+            return headSize + found;
+    }
+    if (!pattern.empty() && !text.tail.empty()) {
+        const std::size_t firstCrossing = headSize >= pattern.size() ? headSize - pattern.size() + 1 : 0;
+        for (std::size_t start = std::min(lastStart + 1, headSize); start > firstCrossing; --start)
+            if (matchesAcrossBorder(text, pattern, start - 1))
+                return start - 1;
+    }
+    return text.head.rfind(pattern, lastStart);
+}
+
+std::size_t findFirstOf(const MyStringView& text, std::string_view chars, std::size_t pos) {
+    const CharClass wanted = CharClass::of(chars);
+    for (std::size_t i = pos; i < text.head.size(); ++i)
+        if (wanted.contains(text.head[i]))
+            return i;
+    for (std::size_t i = std::max(pos, text.head.size()) - text.head.size(); i < text.tail.size(); ++i)
+        if (wanted.contains(text.tail[i]))
+            return text.head.size() + i;
+    return npos;
+}
+
+std::vector<std::size_t> findAll(const MyStringView& text, std::string_view pattern) {
+    std::vector<std::size_t> positions;
+    if (pattern.empty())
+        return positions;
+
+    const SubstringSearcher searcher(pattern);
+    for (std::size_t found = searcher.find(text); found != npos; found = searcher.find(text, found + 1))
+        positions.push_back(found);
+    return positions;
+}
+
+} // namespace search
@@ -0,0 +1,54 @@
+#ifndef STRINGSEARCH_H
+#define STRINGSEARCH_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "mystring.h"
+
+
+/// Substring searcher with the pattern preprocessed once. The algorithm is picked by pattern length:
+///  - 1 byte: memchr,
+///  - up to shortPatternLength_ bytes: SSE2 filter on the first and last pattern byte, memcmp of candidates,
+///  - longer: Two-Way (Crochemore-Perrin) with a bad-character shift on the last byte.
+/// The pattern is not copied - it has to outlive the searcher.
+class SubstringSearcher {
+public:
+    static constexpr std::size_t npos = std::string_view::npos;
+    static constexpr std::size_t shortPatternLength_ = 16;
+
+    explicit SubstringSearcher(std::string_view pattern);
+
+    [[nodiscard]] std::size_t find(std::string_view text, std::size_t pos = 0) const;
+    /// Works across both pieces of the view, including matches crossing from head to tail.
+    [[nodiscard]] std::size_t find(const MyStringView& text, std::size_t pos = 0) const;
+
+    [[nodiscard]] std::size_t patternLength() const { return pattern_.size(); }
+
+private:
+    std::string_view pattern_;
+    std::size_t criticalPosition_{};
+    std::size_t period_{};
+    bool periodic_{};
+    std::array<std::size_t, 256> shift_{};
+
+    [[nodiscard]] std::size_t findTwoWay(std::string_view text) const;
+};
+
+
+namespace search {
+
+inline constexpr std::size_t npos = std::string_view::npos;
+
+[[nodiscard]] std::size_t find(const MyStringView& text, std::string_view pattern, std::size_t pos = 0);
+[[nodiscard]] std::size_t rfind(const MyStringView& text, std::string_view pattern, std::size_t pos = npos);
+[[nodiscard]] std::size_t findFirstOf(const MyStringView& text, std::string_view chars, std::size_t pos = 0);
+/// Start positions of all (also overlapping) occurrences, in increasing order.
+[[nodiscard]] std::vector<std::size_t> findAll(const MyStringView& text, std::string_view pattern);
+
+} // namespace search
+
+
+#endif //STRINGSEARCH_H
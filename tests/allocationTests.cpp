@@ -0,0 +1,158 @@
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#if __has_include("../mystring.h")
+    #include "../mystring.h"
+#elif __has_include("mystring.h")
+    #include "mystring.h"
+#else
+    #error "File 'mystring.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+} // namespace
+
+
+/// Allocation budgets - the tests target is built with MYSTRING_COUNT_ALLOCATIONS.
+class AllocationTester : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!allocations::enabled())
+            GTEST_SKIP() << "built without MYSTRING_COUNT_ALLOCATIONS";
+    }
+};
+
+TEST_F(AllocationTester, operationsOnStringsUpToInlineCapacity_expectedNoAllocations)
+{
+    const allocations::Scope scope;
+    {
+        MyString text("  Ala ma Kota  ");
+        MyString copy(text);
+        copy.trim();
+        copy.toLower();
+        copy += MyString("!!");
+        copy.append(std::string_view("abc"));
+        MyString moved(std::move(copy));
+        moved = text;
+        moved = MyString(20, 'x');
+        EXPECT_EQ(20u, moved.size());
+        EXPECT_NE(MyString::npos, text.find("Kota"));
+        EXPECT_TRUE(text < moved || moved < text);
+        EXPECT_EQ('A', text[2]);
+    }
+    EXPECT_EQ(0u, scope.heap().allocations);
+}
+
+TEST_F(AllocationTester, concatenationExpression_expectedOneAllocation)
+{
+    const MyString prefix("prefiks/");
+    const MyString key("klucz dluzszy niz bufor wewnetrzny");
+    const std::string value = "wartosc";
+
+    const allocations::Scope scope;
+    const MyString joined = prefix + key + ":" + value;
+    const MyString concatenated = MyString::concat(prefix, key, ":", value);
+
+    EXPECT_EQ(2u, scope.heap().allocations);
+    EXPECT_EQ(joined.toString(), concatenated.toString());
+}
+
+TEST_F(AllocationTester, toStringAndFindOfLongPattern_expectedOneAllocationEach)
+{
+    const MyString text(std::string(200, 'a').append("wzorzec dluzszy niz bufor wewnetrzny").c_str());
+    const MyString pattern("wzorzec dluzszy niz bufor wewnetrzny");
+
+    const allocations::Scope toStringScope;
+    const std::string copy = text.toString();
+    EXPECT_EQ(1u, toStringScope.heap().allocations);
+    EXPECT_EQ(text.size(), copy.size());
+
+    const allocations::Scope findScope;
+    EXPECT_EQ(200u, text.find(pattern));
+    EXPECT_EQ(200u, text.rfind(pattern));
+    EXPECT_EQ(2u, findScope.heap().allocations);
+}
+
+TEST_F(AllocationTester, movingLongString_expectedNoAllocations)
+{
+    MyString text(1000, 'a');
+    const allocations::Scope scope;
+
+    MyString moved(std::move(text));
+    text = std::move(moved);
+
+    EXPECT_EQ(0u, scope.heap().allocations);
+    EXPECT_EQ(1000u, text.size());
+    EXPECT_TRUE(moved.empty());
+}
+
+TEST_F(AllocationTester, join_expectedOneAllocation)
+{
+    const std::vector<MyString> pieces(100, MyString("kawalek tekstu"));
+    const std::vector<std::string> stdPieces(100, "kawalek tekstu");
+    const MyString separator(", ");
+
+    {
+        const allocations::Scope scope;
+        const MyString joined = separator.join(pieces);
+        EXPECT_EQ(1u, scope.heap().allocations);
+        EXPECT_EQ(1u, scope.myString().allocations);
+        EXPECT_EQ(100 * 14 + 99 * 2u, joined.size());
+    }
+    {
+        const allocations::Scope scope;
+        const MyString joined = separator.join(stdPieces);
+        EXPECT_EQ(1u, scope.heap().allocations);
+    }
+}
+
+TEST_F(AllocationTester, countingWords_expectedAllocationsOnlyForDistinctWords)
+{
+    const MyString once("Ala ma kota, a kot ma Ale. ");
+    MyString repeated;
+    for (int i = 0; i < 1000; ++i)
+        repeated += once;
+    (void)once.countWordsUsageIgnoringCases(); // warm-up
+
+    const allocations::Scope onceScope;
+    const auto onceUsage = once.countWordsUsageIgnoringCases();
+    const std::size_t onceAllocations = onceScope.heap().allocations;
+
+    const allocations::Scope repeatedScope;
+    const auto repeatedUsage = repeated.countWordsUsageIgnoringCases();
+
+    // one map node per distinct word, nothing per occurrence
+    EXPECT_EQ(onceUsage.size(), onceAllocations);
+    EXPECT_EQ(onceAllocations, repeatedScope.heap().allocations);
+    EXPECT_EQ(1000u * 2, repeatedUsage.at("ma"));
+}
+
+TEST_F(AllocationTester, destroyingLongStrings_expectedEveryAllocationReleased)
+{
+    const allocations::Scope scope;
+    {
+        MyString text(100, 'a');
+        text += MyString(200, 'b');
+        MyString copy = text;
+        copy.reserve(10'000);
+    }
+    EXPECT_EQ(scope.myString().allocations, scope.myString().deallocations);
+    EXPECT_GT(scope.myString().allocations, 0u);
+}
+
+TEST_F(AllocationTester, readAllFromSeekableStream_expectedOneStringAllocation)
+{
+    std::istringstream stream(std::string(100'000, 'r'));
+    const allocations::Scope scope;
+    const MyString text = MyString::readAll(stream);
+    EXPECT_EQ(1u, scope.myString().allocations);
+    EXPECT_EQ(100'000u, text.size());
+}
@@ -0,0 +1,111 @@
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#if __has_include("../corpusgenerator.h")
+    #include "../corpusgenerator.h"
+#elif __has_include("corpusgenerator.h")
+    #include "corpusgenerator.h"
+#else
+    #error "File 'corpusgenerator.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+} // namespace
+
+
+class CorpusGeneratorTester : public ::testing::Test
+{
+};
+
+TEST_F(CorpusGeneratorTester, sameSeed_expectedSameTextOfRequestedLength)
+{
+    CorpusOptions options;
+    options.seed = 7;
+    CorpusGenerator first(options), second(options);
+
+    const MyString text = first.generate(200'000);
+    EXPECT_EQ(200'000u, text.size());
+    EXPECT_EQ(text.toString(), second.generate(200'000).toString());
+
+    options.seed = 8;
+    EXPECT_NE(text.toString(), CorpusGenerator(options).generate(200'000).toString());
+}
+
+TEST_F(CorpusGeneratorTester, consecutiveCallsAndStream_expectedOneContinuousText)
+{
+    const MyString whole = CorpusGenerator().generate(150'000);
+
+    CorpusGenerator pieces;
+    std::string joined = pieces.generate(100'001).toString();
+    joined += pieces.generate(49'999).toString();
+    EXPECT_EQ(whole.toString(), joined);
+
+    std::ostringstream out;
+    CorpusGenerator().generate(out, 150'000);
+    EXPECT_EQ(whole.toString(), out.str());
+}
+
+TEST_F(CorpusGeneratorTester, zipfDistribution_expectedFrequencyFallingWithRank)
+{
+    CorpusOptions options;
+    options.vocabularySize = 1'000;
+    options.punctuationProbability = 0.0;
+    options.capitalizedProbability = 0.0;
+    options.upperCaseProbability = 0.0;
+    CorpusGenerator generator(options);
+
+    const auto usage = generator.generate(2'000'000).countWordsUsageIgnoringCases();
+    const auto& vocabulary = generator.vocabulary();
+    ASSERT_EQ(1'000u, vocabulary.size());
+
+    auto countOf = [&](size_t rank) {
+        const auto found = usage.find(MyString(vocabulary[rank].c_str()));
+        return found == usage.end() ? 0.0 : static_cast<double>(found->second);
+    };
+    // with exponent 1 the word with rank r occurs ~r times less often than the first one
+    EXPECT_NEAR(2.0, countOf(0) / countOf(1), 0.2);
+    EXPECT_NEAR(10.0, countOf(0) / countOf(9), 1.0);
+    EXPECT_GT(countOf(9), countOf(99));
+}
+
+TEST_F(CorpusGeneratorTester, options_expectedWordLengthsPunctuationAndCase)
+{
+    CorpusOptions options;
+    options.minWordLength = 3;
+    options.maxWordLength = 6;
+    options.punctuationProbability = 0.5;
+    options.capitalizedProbability = 0.5;
+    CorpusGenerator generator(options);
+
+    for (const auto& word: generator.vocabulary()) {
+        EXPECT_GE(word.size(), 3u);
+        EXPECT_LE(word.size(), 7u); // may be longer than maxWordLength only when short words run out
+    }
+
+    const std::string text = generator.generate(100'000).toString();
+    EXPECT_NE(std::string::npos, text.find_first_of(",.;:!?"));
+    EXPECT_NE(std::string::npos, text.find_first_of("ABCDEFGHIJKLMNOPQRSTUVWXYZ"));
+    EXPECT_EQ(std::string::npos, text.find_first_of("0123456789\t"));
+}
+
+TEST_F(CorpusGeneratorTester, wordLengths_expectedMeanOfOptionsAndSameWordsOnEveryStandardLibrary)
+{
+    CorpusOptions options;
+    options.seed = 7;
+    options.meanWordLength = 6.0;
+    const CorpusGenerator generator(options);
+
+    double lengths = 0;
+    for (const auto& word: generator.vocabulary())
+        lengths += static_cast<double>(word.size());
+    EXPECT_NEAR(6.0, lengths / static_cast<double>(generator.vocabulary().size()), 0.2);
+
+    // lengths and letters come from FastRandom only - no implementation-defined <random> distributions
+    const vector<string> firstWords(generator.vocabulary().begin(), generator.vocabulary().begin() + 3);
+    EXPECT_EQ((vector<string>{"eighmp", "amazoscwi", "nui"}), firstWords);
+}
@@ -0,0 +1,173 @@
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <unordered_set>
+#include <gtest/gtest.h>
+
+#if __has_include("../fixedmystring.h")
+    #include "../fixedmystring.h"
+#elif __has_include("fixedmystring.h")
+    #include "fixedmystring.h"
+#else
+    #error "File 'fixedmystring.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+
+using Word = FixedMyString<32>;
+
+static_assert(is_trivially_copyable_v<Word>);
+static_assert(sizeof(FixedMyString<14>) == 16);
+} // namespace
+
+
+class FixedMyStringTester : public ::testing::Test
+{
+};
+
+TEST_F(FixedMyStringTester, textLongerThanMyStringInlineBuffer_expectedKeptInlineAndWithoutAllocation)
+{
+    if (!allocations::enabled())
+        GTEST_SKIP() << "built without MYSTRING_COUNT_ALLOCATIONS";
+
+    const MyString source("a word of twenty-eight chars");
+    ASSERT_GT(source.size(), static_cast<size_t>(MyString::initialBufferSize_));
+
+    const allocations::Scope scope;
+    Word word(source);
+    word += ' ';
+    word.append("ok").appendNumber(42);
+    const Word copy = word;
+    EXPECT_EQ(0u, scope.heap().allocations);
+
+    EXPECT_EQ("a word of twenty-eight chars ok4", copy);
+    EXPECT_TRUE(copy.full());
+    EXPECT_EQ(errc::value_too_large, copy.error());
+}
+
+TEST_F(FixedMyStringTester, truncatePolicy_expectedPrefixKeptAndErrorSet)
+{
+    FixedMyString<8> text("overflowing");
+    EXPECT_EQ("overflow", text);
+    EXPECT_EQ(errc::value_too_large, text.error());
+
+    text.clear();
+    text.append("fits");
+    EXPECT_EQ(errc(), text.error());
+}
+
+TEST_F(FixedMyStringTester, errorCodePolicy_expectedStringUnchangedAndErrorSet)
+{
+    FixedMyString<8, OverflowPolicy::errorCode> text("12345");
+    text.append("6789");
+    EXPECT_EQ("12345", text);
+    EXPECT_EQ(errc::value_too_large, text.error());
+
+    text.append(MyStringView{"67", "89"});
+    EXPECT_EQ("12345", text);
+    text.append("678");
+    EXPECT_EQ("12345678", text);
+}
+
+TEST_F(FixedMyStringTester, appendNumber_mostNegativeValueInBase2_expectedAllDigitsOrPolicyError)
+{
+    const string intMin = "-1" + string(31, '0');
+    FixedMyString<64> fits;
+    fits.appendNumber(numeric_limits<int>::min(), 2);
+    EXPECT_EQ(intMin, fits);
+    EXPECT_EQ(errc(), fits.error());
+
+    FixedMyString<20, OverflowPolicy::errorCode> unchanged("x");
+    unchanged.appendNumber(numeric_limits<int>::min(), 2);
+    EXPECT_EQ("x", unchanged);
+    EXPECT_EQ(errc::value_too_large, unchanged.error());
+
+    FixedMyString<20> truncated;
+    truncated.appendNumber(numeric_limits<long long>::min(), 2);
+    EXPECT_EQ(intMin.substr(0, 20), truncated);
+    EXPECT_EQ(errc::value_too_large, truncated.error());
+}
+
+TEST_F(FixedMyStringTester, terminatePolicy_expectedTerminateOnOverflow)
+{
+    EXPECT_DEATH((FixedMyString<4, OverflowPolicy::terminate>("too long")), "");
+}
+
+TEST_F(FixedMyStringTester, conversionToAndFromMyString_expectedSameContent)
+{
+    const MyString source("longer than the inline buffer of MyString");
+    const FixedMyString<64> fixed(source);
+    EXPECT_EQ(source, fixed.toMyString());
+    EXPECT_EQ(source, MyString(fixed));
+    EXPECT_TRUE(fixed == source);
+    EXPECT_EQ(hash<MyString>{}(source), hash<FixedMyString<64>>{}(fixed));
+
+    const Word shortWord("short");
+    EXPECT_EQ(hash<MyString>{}(MyString("short")), hash<Word>{}(shortWord));
+}
+
+TEST_F(FixedMyStringTester, comparisons_expectedSameOrderAsMyString)
+{
+    const MyString longer("abcdefghijklmnopqrstuvwxyz");
+    EXPECT_LT(Word("abcdefghijklmnopqrstuvwxy"), longer);
+    EXPECT_GT(Word("abcdefghijklmnopqrstuvwxz"), longer);
+    EXPECT_GT(Word("abcdefghijklmnopqrstuvwxyz!"), longer);
+    EXPECT_LT(Word("abc"), Word("abd"));
+    EXPECT_EQ(Word("abc"), FixedMyString<3>("abc"));
+    EXPECT_LT(Word("z"), Word("\xe9"));
+    EXPECT_EQ(string("abc"), Word("abc"));
+}
+
+TEST_F(FixedMyStringTester, trimAndCaseConversion_expectedLikeMyString)
+{
+    Word text("  \tMixed Case Words \n");
+    EXPECT_EQ("Mixed Case Words", text.trimmed());
+    text.trim();
+    EXPECT_EQ("Mixed Case Words", text);
+    EXPECT_EQ("mixed case words", text.toLowerCopy());
+    EXPECT_EQ("MIXED CASE WORDS", text.toUpper());
+    EXPECT_TRUE(text.startsWith("MIXED") && text.endsWith("WORDS") && text.contains("CASE"));
+
+    Word blank("   ");
+    blank.trim();
+    EXPECT_TRUE(blank.empty());
+}
+
+TEST_F(FixedMyStringTester, wordHelpers_expectedLowercaseWords)
+{
+    const FixedMyString<64> text("The cat and the DOG, the end");
+    const auto words = text.getUniqueWords();
+    EXPECT_EQ((set<FixedMyString<64>>{"and", "cat", "dog", "end", "the"}), words);
+    EXPECT_EQ(3u, text.countWordsUsageIgnoringCases().at("the"));
+}
+
+TEST_F(FixedMyStringTester, iteratorsAndIndexing_expectedContiguousCharacters)
+{
+    Word text("abc");
+    EXPECT_EQ("cba", string(text.rbegin(), text.rend()));
+    text[0] = 'x';
+    EXPECT_EQ('x', *text.begin());
+    EXPECT_THROW(text[3], out_of_range);
+    EXPECT_TRUE(text.all_of([](char ch) { return ch >= 'a'; }));
+
+    unordered_set<Word> set{text, Word("other")};
+    EXPECT_TRUE(set.contains(Word("xbc")));
+}
+
+TEST_F(FixedMyStringTester, constexprUse_expectedEvaluatedAtCompileTime)
+{
+    constexpr Word word = [] {
+        Word result("  Compile Time  ");
+        result.trim();
+        result.toLower();
+        return result;
+    }();
+    static_assert(word == "compile time" && word.size() == 12);
+    static_assert(hash<Word>{}(word) == hash<MyString>{}(MyString("compile time")));
+    EXPECT_EQ("compile time", word);
+}
@@ -0,0 +1,102 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <gtest/gtest.h>
+
+#if __has_include("../latencyhistogram.h")
+    #include "../latencyhistogram.h"
+    #include "../mystring.h"
+#elif __has_include("latencyhistogram.h")
+    #include "latencyhistogram.h"
+    #include "mystring.h"
+#else
+    #error "File 'latencyhistogram.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+} // namespace
+
+
+class LatencyHistogramTester : public ::testing::Test
+{
+};
+
+TEST_F(LatencyHistogramTester, bucketBounds_expectedRelativeErrorBelowFourPercent)
+{
+    for (uint64_t value: {0ull, 1ull, 63ull, 64ull, 65ull, 1000ull, 123'456ull, 999'999'999ull, 1ull << 38}) {
+        const uint64_t upper = LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketOf(value));
+        EXPECT_GE(upper, value);
+        EXPECT_LE(static_cast<double>(upper - value), 0.04 * static_cast<double>(value)) << value;
+    }
+    EXPECT_EQ(LatencyHistogram::bucketCount - 1, LatencyHistogram::bucketOf(UINT64_MAX));
+}
+
+TEST_F(LatencyHistogramTester, percentiles_expectedValuesOfUniformDistribution)
+{
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10'000; ++value)
+        histogram.record(value);
+
+    EXPECT_EQ(10'000u, histogram.count());
+    EXPECT_EQ(10'000u, histogram.max());
+    EXPECT_DOUBLE_EQ(5000.5, histogram.mean());
+    EXPECT_NEAR(5000.0, static_cast<double>(histogram.percentile(50)), 5000 * 0.04);
+    EXPECT_NEAR(9900.0, static_cast<double>(histogram.percentile(99)), 9900 * 0.04);
+    EXPECT_EQ(10'000u, histogram.percentile(100));
+
+    LatencyHistogram merged(histogram);
+    merged.merge(histogram);
+    EXPECT_EQ(20'000u, merged.count());
+    EXPECT_EQ(histogram.percentile(90), merged.percentile(90));
+}
+
+TEST_F(LatencyHistogramTester, myStringOperationsInSeveralThreads_expectedAllRecorded)
+{
+    if (!latency::enabled())
+        GTEST_SKIP() << "built without MYSTRING_LATENCY_HISTOGRAMS";
+    latency::reset();
+
+    auto work = [] {
+        MyString text("  Ala ma kota, a kot ma Ale  ");
+        for (int i = 0; i < 100; ++i)
+            text.append(std::string_view("tekst "));
+        text.trim();
+        (void)std::hash<MyString>{}(text);
+        (void)text.countWordsUsageIgnoringCases();
+    };
+    std::thread other(work);
+    work();
+    other.join(); // the histograms of the finished thread stay in the report
+
+    EXPECT_EQ(2 * 100u, latency::snapshot(latency::Operation::append).count());
+    EXPECT_EQ(2u, latency::snapshot(latency::Operation::trim).count());
+    EXPECT_EQ(2u, latency::snapshot(latency::Operation::hash).count());
+    EXPECT_EQ(2u, latency::snapshot(latency::Operation::countWords).count());
+    EXPECT_GT(latency::snapshot(latency::Operation::compare).count(), 0u);
+    EXPECT_GT(latency::snapshot(latency::Operation::countWords).percentile(99), 0u);
+
+    std::ostringstream report;
+    latency::dumpText(report);
+    EXPECT_NE(std::string::npos, report.str().find("countWords 2 "));
+}
+
+TEST_F(LatencyHistogramTester, appendOfBothPartsAndJoin_expectedOneSamplePerPublicCall)
+{
+    if (!latency::enabled())
+        GTEST_SKIP() << "built without MYSTRING_LATENCY_HISTOGRAMS";
+    latency::reset();
+
+    const MyString longText("tekst dluzszy niz bufor wewnetrzny");
+    MyString text("poczatek ");
+    text.append(longText.view());
+    text += longText;
+    text += text;
+    (void)MyString(", ").join(std::vector<MyString>{longText, longText, longText});
+
+    EXPECT_EQ(3u, latency::snapshot(latency::Operation::append).count());
+}
@@ -0,0 +1,113 @@
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#if __has_include("../linebatch.h")
+    #include "../linebatch.h"
+    #include "../corpusgenerator.h"
+#elif __has_include("linebatch.h")
+    #include "linebatch.h"
+    #include "corpusgenerator.h"
+#else
+    #error "File 'linebatch.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+
+vector<string> readAllLines(LineBatchReader& reader)
+{
+    vector<string> lines;
+    LineBatch batch;
+    while (reader.next(batch))
+        for (const string_view line: batch)
+            lines.emplace_back(line);
+    return lines;
+}
+
+vector<string> getlineReference(const string& text)
+{
+    vector<string> lines;
+    istringstream in(text);
+    for (string line; getline(in, line);)
+        lines.push_back(line);
+    return lines;
+}
+} // namespace
+
+
+class LineBatchTester : public ::testing::Test
+{
+};
+
+TEST_F(LineBatchTester, smallBlocks_expectedSameLinesAsGetline)
+{
+    const vector<string> texts{
+        "", "\n", "\n\n\n", "one", "one\n", "one\ntwo", "one\ntwo\n", "a\r\nb\r\n",
+        "line longer than every block size used in this test\nshort\n\nlast without newline"
+    };
+    for (const string& text: texts)
+        for (const size_t blockSize: {1u, 2u, 3u, 7u, 16u, 17u, 64u, 4096u})
+        {
+            istringstream in(text);
+            LineBatchReader reader(in, blockSize);
+            EXPECT_EQ(getlineReference(text), readAllLines(reader)) << '"' << text << "\" block " << blockSize;
+        }
+}
+
+TEST_F(LineBatchTester, generatedCorpus_expectedSameLinesAsGetline)
+{
+    CorpusOptions options;
+    options.newlineProbability = 0.2;
+    const string text = CorpusGenerator(options).generate(1 << 20).toString();
+
+    istringstream in(text);
+    LineBatchReader reader(in, 1000);
+    EXPECT_EQ(getlineReference(text), readAllLines(reader));
+}
+
+TEST_F(LineBatchTester, batch_expectedIndexableViewsIntoOneBuffer)
+{
+    istringstream in("alpha beta\ngamma\n\ndelta");
+    LineBatchReader reader(in);
+    LineBatch batch;
+
+    ASSERT_TRUE(reader.next(batch));
+    ASSERT_EQ(4u, batch.size());
+    EXPECT_EQ("alpha beta", batch[0]);
+    EXPECT_EQ("gamma", batch.at(1));
+    EXPECT_TRUE(batch[2].empty());
+    EXPECT_EQ("delta", batch.view(3).toString());
+    EXPECT_EQ(23u, batch.bytes());
+    EXPECT_EQ(batch[0].data() + 11, batch[1].data());
+    EXPECT_THROW((void)batch.at(4), std::out_of_range);
+
+    EXPECT_FALSE(reader.next(batch));
+    EXPECT_TRUE(batch.empty());
+    EXPECT_FALSE(reader.next(batch));
+}
+
+TEST_F(LineBatchTester, fileDescriptor_expectedLinesReadFromPipe)
+{
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    const string text = "first\nsecond\nthird";
+    ASSERT_EQ(static_cast<ssize_t>(text.size()), write(fds[1], text.data(), text.size()));
+    close(fds[1]);
+
+    LineBatchReader reader(fds[0], 4);
+    EXPECT_EQ((vector<string>{"first", "second", "third"}), readAllLines(reader));
+    close(fds[0]);
+}
+
+TEST_F(LineBatchTester, invalidDescriptor_expectedSystemError)
+{
+    LineBatchReader reader(-1);
+    LineBatch batch;
+    EXPECT_THROW(reader.next(batch), std::system_error);
+}
@@ -0,0 +1,113 @@
+#include <iterator>
+#include <limits>
+#include <string>
+#include <gtest/gtest.h>
+
+#if __has_include("../mystringbuilder.h")
+    #include "../mystringbuilder.h"
+#elif __has_include("mystringbuilder.h")
+    #include "mystringbuilder.h"
+#else
+    #error "File 'mystringbuilder.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+} // namespace
+
+
+class MyStringBuilderTester : public ::testing::Test
+{
+};
+
+TEST_F(MyStringBuilderTester, emptyBuilder_expectedEmptyString)
+{
+    const MyStringBuilder builder;
+    EXPECT_TRUE(builder.empty());
+    EXPECT_TRUE(builder.build().empty());
+    EXPECT_EQ(0u, builder.chunkCount());
+}
+
+TEST_F(MyStringBuilderTester, appendingAcrossChunks_expectedTextInOrder)
+{
+    MyStringBuilder builder(8);
+    string expected;
+
+    builder.append('<').append("short").append(MyString("a MyString longer than the inline buffer"));
+    builder += MyStringView{"head|", "tail"};
+    builder += '>';
+    builder.appendNumber(-1234567890123LL).append(' ').appendNumber(255u, 16).append(' ').appendNumber(0.5);
+    expected = "<shorta MyString longer than the inline bufferhead|tail>-1234567890123 ff 0.5";
+
+    EXPECT_EQ(expected.size(), builder.size());
+    EXPECT_EQ(expected, builder.build().toString());
+    EXPECT_EQ((expected.size() + 7) / 8, builder.chunkCount());
+}
+
+TEST_F(MyStringBuilderTester, appendNumber_mostNegativeValueInBase2_expectedSignAndAllDigits)
+{
+    const string expected = "-1" + string(31, '0') + " -1" + string(63, '0');
+    for (const size_t chunkSize: {size_t{8}, size_t{4096}}) // through the stack buffer and straight into the chunk
+    {
+        MyStringBuilder builder(chunkSize);
+        builder.appendNumber(numeric_limits<int>::min(), 2).append(' ').appendNumber(numeric_limits<long long>::min(), 2);
+        EXPECT_EQ(expected, builder.build().toString()) << chunkSize;
+    }
+}
+
+TEST_F(MyStringBuilderTester, backInserter_expectedCharactersAppended)
+{
+    MyStringBuilder builder(3);
+    const string text = "copied through an output iterator";
+    copy(text.begin(), text.end(), back_inserter(builder));
+    EXPECT_EQ(text, builder.build().toString());
+}
+
+TEST_F(MyStringBuilderTester, reset_expectedChunksReusedForNextText)
+{
+    MyStringBuilder builder(16);
+    for (int i = 0; i < 100; ++i)
+        builder.appendNumber(i).append(',');
+    const size_t chunks = builder.chunkCount();
+
+    builder.reset();
+    EXPECT_TRUE(builder.empty());
+    builder.append("next");
+    EXPECT_EQ("next", builder.build().toString());
+    EXPECT_EQ(chunks, builder.chunkCount());
+}
+
+#if defined(__cpp_lib_format)
+TEST_F(MyStringBuilderTester, appendFormatted_expectedFormattedText)
+{
+    MyStringBuilder builder(4);
+    builder.appendFormatted("{}-{:>5}|{:.2f}", "id", 42, 2.5);
+    EXPECT_EQ("id-   42|2.50", builder.build().toString());
+}
+#endif
+
+TEST_F(MyStringBuilderTester, buildAndReuse_expectedOneAllocationForResultAndNoneForChunks)
+{
+    if (!allocations::enabled())
+        GTEST_SKIP() << "built without MYSTRING_COUNT_ALLOCATIONS";
+
+    MyStringBuilder builder(64);
+    const auto fill = [&] {
+        for (size_t i = 0; i < 1000; ++i)
+            builder.append("word").appendNumber(i).append(' ');
+    };
+    fill();
+    {
+        const allocations::Scope scope;
+        const MyString text = builder.build();
+        EXPECT_EQ(1u, scope.heap().allocations);
+        EXPECT_EQ(builder.size(), text.size());
+    }
+
+    builder.reset();
+    const allocations::Scope scope;
+    fill();
+    EXPECT_EQ(0u, scope.heap().allocations);
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+
+#if __has_include("../mystringmatcher.h")
+    #include "../mystringmatcher.h"
+#elif __has_include("mystringmatcher.h")
+    #include "mystringmatcher.h"
+#else
+    #error "File 'mystringmatcher.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+
+vector<MyStringMatcher::Match> sorted(vector<MyStringMatcher::Match> matches)
+{
+    sort(matches.begin(), matches.end(), [](const auto& lhs, const auto& rhs) {
+        return tie(lhs.position, lhs.pattern) < tie(rhs.position, rhs.pattern);
+    });
+    return matches;
+}
+} // namespace
+
+
+class MyStringMatcherTester : public ::testing::Test
+{
+};
+
+TEST_F(MyStringMatcherTester, overlappingPatterns_expectedAllOccurrencesLikeFindAll)
+{
+    const vector<MyString> patterns = {"he", "she", "his", "hers", "s", "ushers and"};
+    const MyString text("ushers and his sheep: she sells, he hears hers");
+    const MyStringMatcher matcher(patterns);
+
+    vector<MyStringMatcher::Match> expected;
+    for (size_t index = 0; index < patterns.size(); ++index)
+        for (const size_t position : text.find_all(patterns[index].toString()))
+            expected.push_back({index, position});
+
+    EXPECT_EQ(sorted(expected), sorted(matcher.findAll(text)));
+    EXPECT_FALSE(matcher.containsAny(MyString("nic tu nie ma")));
+}
+
+TEST_F(MyStringMatcherTester, ignoringCases_expectedMatchesRegardlessOfLetterCase)
+{
+    const MyStringMatcher matcher({"Woznico", "krol"}, true);
+    const MyString text("WOZNICO, moj drogi woznico - KrOl");
+
+    const vector<MyStringMatcher::Match> expected = {{0, 0}, {0, 19}, {1, 29}};
+    EXPECT_EQ(expected, matcher.findAll(text));
+    EXPECT_TRUE(MyStringMatcher({"krol"}).findAll(text).empty());
+}
+
+TEST_F(MyStringMatcherTester, manyPatterns_expectedEachOneFoundOnceInConcatenation)
+{
+    vector<MyString> patterns;
+    MyString text;
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        patterns.push_back(MyString(("#" + to_string(i * 7919) + "#").c_str()));
+        text += patterns.back();
+    }
+
+    const MyStringMatcher matcher(patterns);
+    const auto matches = matcher.findAll(text);
+
+    ASSERT_EQ(patterns.size(), matches.size());
+    for (size_t i = 0; i < matches.size(); ++i)
+        EXPECT_EQ(i, matches[i].pattern);
+}
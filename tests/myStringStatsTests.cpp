@@ -0,0 +1,84 @@
+#include <sstream>
+#include <string>
+#include <gtest/gtest.h>
+
+#if __has_include("../mystringstats.h")
+    #include "../mystringstats.h"
+    #include "../mystring.h"
+#elif __has_include("mystringstats.h")
+    #include "mystringstats.h"
+    #include "mystring.h"
+#else
+    #error "File 'mystringstats.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+} // namespace
+
+
+/// The tests target is built with MYSTRING_COLLECT_STATS.
+class MyStringStatsTester : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!stringstats::enabled())
+            GTEST_SKIP() << "built without MYSTRING_COLLECT_STATS";
+        stringstats::reset();
+    }
+};
+
+TEST_F(MyStringStatsTester, constructions_expectedLengthHistogram)
+{
+    const MyString shortText("abc");
+    const MyString copy(shortText);
+    const MyString longText(2000, 'x');
+    const MyString fromView(longText.view().substr(0, 25));
+
+    const auto stats = stringstats::snapshot();
+    EXPECT_EQ(4u, stats.constructions());
+    EXPECT_EQ(2u, stats.lengthCounts[3]);
+    EXPECT_EQ(1u, stats.lengthCounts[25]);
+    EXPECT_EQ(1u, stats.longerCount);
+    EXPECT_EQ(2000u, stats.longerTotalLength);
+    EXPECT_EQ(2000u, stats.maxLength);
+    EXPECT_EQ(static_cast<size_t>(MyString::initialBufferSize_), stats.inlineCapacity);
+}
+
+TEST_F(MyStringStatsTester, appendingPastInlineCapacity_expectedOneSpillAndHeapGrowth)
+{
+    MyString text;
+    for (int i = 0; i < 200; ++i)
+        text += 'a';
+
+    const auto stats = stringstats::snapshot();
+    EXPECT_EQ(1u, stats.spills);
+    EXPECT_EQ(1u, stats.heapAllocations);
+    EXPECT_GT(stats.reallocations, 0u);
+    EXPECT_LT(stats.reallocations, 10u); // geometric growth
+}
+
+TEST_F(MyStringStatsTester, textDump_expectedSameStatisticsAfterParsing)
+{
+    const MyString a("ala ma kota"), b(100, 'b');
+    MyString c("c");
+    c.append(std::string_view("0123456789012345678901234567890123456789"));
+
+    const auto stats = stringstats::snapshot();
+    std::stringstream dump;
+    stringstats::dumpText(dump, stats);
+    const auto parsed = stringstats::parseText(dump);
+
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(stats.lengthCounts, parsed->lengthCounts);
+    EXPECT_EQ(stats.constructions(), parsed->constructions());
+    EXPECT_EQ(stats.spills, parsed->spills);
+    EXPECT_EQ(stats.heapAllocations, parsed->heapAllocations);
+    EXPECT_EQ(stats.maxLength, parsed->maxLength);
+
+    std::stringstream notADump("zupelnie cos innego");
+    EXPECT_FALSE(stringstats::parseText(notADump).has_value());
+}
@@ -4,6 +4,9 @@
 #include <functional>  // std::bind2nd, std::not_equal_to
 #include <cctype>      // isspace, isalpha, ...
 #include <cstring>
+#include <ranges>
+#include <sstream>
+#include <iomanip>
 #include <gtest/gtest.h>
 
 #if __has_include("../mystring.h")
@@ -14,6 +17,12 @@
     #error "File 'mystring.h' not found!"
 #endif
 
+#if __has_include("../wordtokenizer.h")
+    #include "../wordtokenizer.h"
+#else
+    #include "wordtokenizer.h"
+#endif
+
 namespace
 {
 using namespace std;
@@ -117,6 +126,137 @@ TEST_F(MyStringTester, istreamOperator_expectedTextCopiedFromStreamToString)
     }
 }
 
+TEST_F(MyStringTester, ostreamOperator_withWidth_expectedPaddingLikeStdString)
+{
+    const MyString shortText("abc");
+    const MyString longText(30, 'z');
+    ostringstream stream;
+    stream << setw(6) << shortText << '|' << left << setfill('.') << setw(5) << shortText << '|' << setw(3) << longText;
+    EXPECT_EQ("   abc|abc..|" + string(30, 'z'), stream.str());
+}
+
+namespace
+{
+/// Accepts at most capacity characters and counts sync() calls (flushes).
+class LimitedBuffer : public std::streambuf
+{
+public:
+    explicit LimitedBuffer(size_t capacity) : capacity_(capacity) {}
+
+    string text;
+    int syncs = 0;
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (traits_type::eq_int_type(ch, traits_type::eof()))
+            return traits_type::not_eof(ch);
+        if (text.size() >= capacity_)
+            return traits_type::eof();
+        text += traits_type::to_char_type(ch);
+        return ch;
+    }
+    int sync() override
+    {
+        ++syncs;
+        return 0;
+    }
+
+private:
+    size_t capacity_;
+};
+} // namespace
+
+TEST_F(MyStringTester, ostreamOperator_sentry_expectedTiedStreamFlushedAndFailedStreamUntouched)
+{
+    const MyString longText("tekst dluzszy niz bufor wewnetrzny");
+    LimitedBuffer tiedBuffer(100);
+    ostream tied(&tiedBuffer);
+    ostringstream stream;
+    stream.tie(&tied);
+
+    stream << setw(100) << setfill('-') << longText;
+    EXPECT_EQ(1, tiedBuffer.syncs);
+    EXPECT_EQ(string(100 - longText.size(), '-') + longText.toString(), stream.str());
+    EXPECT_EQ(0, stream.width());
+
+    stream.setstate(ios_base::failbit);
+    stream << longText;
+    EXPECT_EQ(100u, stream.str().size());
+}
+
+TEST_F(MyStringTester, ostreamOperator_shortWrite_expectedBadbit)
+{
+    LimitedBuffer buffer(10);
+    ostream out(&buffer);
+    out << setw(40) << MyString("tekst dluzszy niz bufor wewnetrzny");
+    EXPECT_TRUE(out.bad());
+    EXPECT_EQ("      teks", buffer.text);
+}
+
+TEST_F(MyStringTester, istreamOperator_linesOfDifferentLengths_expectedOneLinePerExtraction)
+{
+    const string exactlyInline(MyString::initialBufferSize_, 'e');
+    const string longLine(3 * MyString::initialBufferSize_ + 1, 'l');
+    istringstream stream("krotka\n\n" + exactlyInline + "\n" + longLine + "\nostatnia bez konca linii " + longLine);
+
+    MyString line;
+    ASSERT_TRUE(stream >> line);
+    EXPECT_EQ("krotka", line.toString());
+    ASSERT_TRUE(stream >> line);
+    EXPECT_TRUE(line.empty());
+    ASSERT_TRUE(stream >> line);
+    EXPECT_EQ(exactlyInline, line.toString());
+    ASSERT_TRUE(stream >> line);
+    EXPECT_EQ(longLine, line.toString());
+    ASSERT_TRUE(stream >> line);
+    EXPECT_EQ("ostatnia bez konca linii " + longLine, line.toString());
+    EXPECT_TRUE(stream.eof());
+
+    EXPECT_FALSE(stream >> line);
+    EXPECT_TRUE(line.empty());
+}
+
+namespace
+{
+/// Stream buffer which cannot seek, like a pipe.
+class ForwardOnlyBuffer : public std::streambuf
+{
+public:
+    explicit ForwardOnlyBuffer(string text) : text_(std::move(text))
+    {
+        setg(text_.data(), text_.data(), text_.data() + text_.size());
+    }
+
+private:
+    string text_;
+};
+} // namespace
+
+TEST_F(MyStringTester, readAll_seekableAndForwardOnlyStreams_expectedWholeRestOfStream)
+{
+    string content;
+    for (int i = 0; content.size() < 200'000; ++i)
+        content += "wiersz " + to_string(i) + '\n';
+
+    istringstream seekable("naglowek\n" + content);
+    MyString header;
+    seekable >> header;
+    const MyString rest = MyString::readAll(seekable);
+    EXPECT_EQ(content, rest.toString());
+    EXPECT_TRUE(seekable.eof());
+    EXPECT_FALSE(seekable.fail());
+
+    ForwardOnlyBuffer buffer(content);
+    istream forwardOnly(&buffer);
+    EXPECT_EQ(content, MyString::readAll(forwardOnly).toString());
+
+    istringstream shortStream("abc");
+    const MyString shortText = MyString::readAll(shortStream);
+    EXPECT_EQ("abc", shortText.toString());
+    EXPECT_EQ(3u, shortText.size());
+}
+
 // use: std::find_if_not, std::copy, ::isspace
 TEST_F(MyStringTester, trimming_expectedSpacesRemoved)
 {
@@ -163,6 +303,38 @@ TEST_F(MyStringTester, trimming_expectedSpacesRemoved)
     }
 }
 
+TEST_F(MyStringTester, trimming_whitespaceOtherThanSpaces_expectedContentPreserved)
+{
+    const string content = "Zawartosc \t dluzsza niz " + string(MyString::initialBufferSize_, '#') + " bufor";
+    for (const size_t leading : {size_t{0}, size_t{1}, size_t{7}, size_t{19}, size_t{20}, size_t{21}, size_t{45}})
+    {
+        for (const size_t trailing : {size_t{0}, size_t{3}, size_t{33}})
+        {
+            const string padded = string(leading, '\n') + content + string(trailing, '\t');
+            MyString text(padded.c_str());
+
+            EXPECT_TRUE(text.trimmed() == content) << "leading = " << leading << ", trailing = " << trailing;
+            text.trim();
+            ASSERT_EQ(content, text.toString()) << "leading = " << leading << ", trailing = " << trailing;
+        }
+    }
+
+    MyString onlyWhitespaces(" \v\f\r\n\t                               ");
+    EXPECT_TRUE(onlyWhitespaces.trimmed().empty());
+    onlyWhitespaces.trim();
+    EXPECT_TRUE(onlyWhitespaces.empty());
+}
+
+TEST_F(MyStringTester, trimmed_expectedViewWithoutCopy)
+{
+    const MyString text("   Wiedza jest skarbem, ale praktyka jest kluczem do niego.  ");
+    const MyStringView view = text.trimmed();
+
+    EXPECT_EQ(string("Wiedza jest skarbem, ale praktyka jest kluczem do niego."), view.toString());
+    EXPECT_EQ(string("Wiedza jest skarbem, ale praktyka jest kluczem do niego."), MyString(view).toString());
+    EXPECT_EQ(text.view().head.data() + 3, view.head.data());
+}
+
 TEST_F(MyStringTester, operatorPlusEqual_expectedTextConcatenation)
 {
     // source: http://cytatybaza.pl/cytat/jest-tylko-jedno-dobro-wiedza-i-jedno-zlo.html
@@ -320,6 +492,35 @@ TEST_F(MyStringTester, wordsIntoLowerCase)
     ASSERT_EQ(string(quoteLowerCase), stream.str());
 }
 
+TEST_F(MyStringTester, wordsIntoUpperCase_nonAsciiBytesUntouched)
+{
+    const char quote[] = "Zolw \xc5\xbc\xc3\xb3\xc5\x82w i [inne] zwierzeta_1234 `{~}` @ Z";
+    const char quoteUpperCase[] = "ZOLW \xc5\xbc\xc3\xb3\xc5\x82W I [INNE] ZWIERZETA_1234 `{~}` @ Z";
+
+    MyString text(quote);
+    text.toUpper();
+    EXPECT_EQ(string(quoteUpperCase), text.toString());
+
+    text.foldCase();
+    EXPECT_EQ(string(quoteUpperCase), text.toUpper().toString());
+}
+
+TEST_F(MyStringTester, toLowerCopy_intoPreallocatedDestination_expectedSourceUnchanged)
+{
+    const char quote[] = "Ucz sie, jak gdybys mial zyc wiecznie, ZYJ JAK GDYBYS MIAL UMRZEC JUTRO";
+    const char quoteLowerCase[] = "ucz sie, jak gdybys mial zyc wiecznie, zyj jak gdybys mial umrzec jutro";
+    const MyString text(quote);
+
+    MyString destination(string(200, 'x').c_str());
+    const auto capacityBefore = destination.capacity();
+    text.toLowerCopy(destination);
+
+    EXPECT_EQ(string(quoteLowerCase), destination.toString());
+    EXPECT_EQ(capacityBefore, destination.capacity());
+    EXPECT_EQ(string(quote), text.toString());
+    EXPECT_EQ(string("abc"), MyString("AbC").toLowerCopy().toString());
+}
+
 // use: std::generate_n, std::back_inserter
 TEST_F(MyStringTester, randomWordGeneration)
 {
@@ -332,6 +533,52 @@ TEST_F(MyStringTester, randomWordGeneration)
     }
 }
 
+TEST_F(MyStringTester, find_patternsOfDifferentLengths_expectedSameResultsAsStdString)
+{
+    // source of quote: Seneka Mlodszy
+    const string quote = "Nie dlatego nie osmielamy sie, ze rzeczy sa trudne, "
+                         "lecz dlatego sa trudne, ze nie osmielamy sie. "
+                         "Nie dlatego nie osmielamy sie, ze rzeczy sa trudne.";
+    const MyString text(quote.c_str());
+    for (const string pattern : {"N", "sie", "y sa tr", "rzeczy", "dlatego nie osmielamy", "zeczy sa trudne, lecz dlatego sa trudne", "brak"})
+    {
+        EXPECT_EQ(quote.find(pattern), text.find(pattern.c_str())) << pattern;
+        EXPECT_EQ(quote.find(pattern, 30), text.find(pattern.c_str(), 30)) << pattern;
+        EXPECT_EQ(quote.rfind(pattern), text.rfind(pattern.c_str())) << pattern;
+        EXPECT_EQ(quote.find(pattern) != string::npos, text.contains(MyString(pattern.c_str()))) << pattern;
+    }
+    EXPECT_EQ(quote.find_first_of(",."), text.find_first_of(",."));
+    EXPECT_EQ(MyString::npos, text.find_first_of("@#"));
+}
+
+TEST_F(MyStringTester, find_matchCrossingInlineBuffer_expectedFound)
+{
+    const string beforeBorder(MyString::initialBufferSize_ - 4, '.');
+    const MyString text((beforeBorder + "granica" + beforeBorder + "granica").c_str());
+
+    EXPECT_EQ(beforeBorder.size(), text.find("granica"));
+    EXPECT_EQ(2 * beforeBorder.size() + 7, text.rfind("granica"));
+    EXPECT_EQ((vector<size_t>{beforeBorder.size(), 2 * beforeBorder.size() + 7}), text.find_all("granica"));
+    EXPECT_EQ((vector<size_t>{0, 1, 2}), MyString("aaaa").find_all("aa"));
+}
+
+TEST_F(MyStringTester, randomWordGeneration_sameSeed_expectedSameWords)
+{
+    constexpr size_t wordLength = 57;
+    MyString::seedRandomWords(2024);
+    const auto firstWord = MyString::generateRandomWord(wordLength);
+    MyString::seedRandomWords(2024);
+    const auto secondWord = MyString::generateRandomWord(wordLength);
+
+    FastRandom generator(2024);
+    const auto wordFromOwnGenerator = MyString::generateRandomWord(wordLength, generator);
+
+    EXPECT_EQ(firstWord.toString(), secondWord.toString());
+    EXPECT_EQ(firstWord.toString(), wordFromOwnGenerator.toString());
+    EXPECT_TRUE(firstWord.all_of([](char ch) { return 'a' <= ch && ch <= 'z'; })) << firstWord;
+    EXPECT_NE(firstWord.toString(), MyString::generateRandomWord(wordLength).toString());
+}
+
 // use: std::search
 TEST_F(MyStringTester, startsWith)
 {
@@ -360,6 +607,18 @@ TEST_F(MyStringTester, endsWith)
     EXPECT_TRUE(text.endsWith("sprawiedliwy."));
     EXPECT_FALSE(text.endsWith("lajdacki"));
 }
+TEST_F(MyStringTester, startsWithEndsWith_patternLongerThanText_expectedFalse)
+{
+    const MyString text("Krotki tekst");
+    const MyString longer("Krotki tekst, ale dluzszy niz bufor");
+
+    EXPECT_FALSE(text.startsWith(longer));
+    EXPECT_FALSE(text.endsWith(longer));
+    EXPECT_TRUE(longer.startsWith(text));
+    EXPECT_TRUE(longer.endsWith("dluzszy niz bufor"));
+    EXPECT_TRUE(text.startsWith(""));
+    EXPECT_TRUE(text.endsWith(text));
+}
 // use: std::mismatch
 TEST_F(MyStringTester, comparingTexts)
 {
@@ -397,6 +656,40 @@ TEST_F(MyStringTester, joiningContainer)
     ASSERT_EQ(polishExtinctAnimalsAsString, joinedText);
 }
 
+TEST_F(MyStringTester, joiningRanges_expectedSameTextForDifferentElementTypes)
+{
+    const MyString separator = " | ";
+    const vector<string> stdStrings = {"tarpan", "tur", "drop zwyczajny", "jaszczurka zielona"};
+    const string expected = "tarpan | tur | drop zwyczajny | jaszczurka zielona";
+
+    EXPECT_EQ(expected, separator.join(stdStrings).toString());
+    EXPECT_EQ(expected, separator.join(stdStrings | views::transform([](const string& text) { return string_view(text); })).toString());
+    EXPECT_EQ(expected, separator.join(array<const char*, 4>{"tarpan", "tur", "drop zwyczajny", "jaszczurka zielona"}).toString());
+    EXPECT_EQ(string("a"), separator.join(vector<MyString>{"a"}).toString());
+    EXPECT_TRUE(separator.join(vector<MyString>{}).empty());
+
+    istringstream stream("tarpan tur");
+    EXPECT_EQ(string("tarpan | tur"), separator.join(views::istream<string>(stream)).toString());
+}
+
+TEST_F(MyStringTester, joiningInParallel_expectedSameTextAsSequentialJoin)
+{
+    vector<MyString> texts;
+    for (size_t i = 0; i < 100000; ++i)
+        texts.push_back(MyString(to_string(i * i).c_str()));
+
+    const MyString separator(", ");
+    EXPECT_EQ(separator.join(texts).toString(), separator.joinParallel(texts, 4).toString());
+    EXPECT_EQ(MyString("").join(texts).toString(), MyString("").joinParallel(texts, 3).toString());
+}
+
+TEST_F(MyStringTester, operatorPlusEqual_appendingItself_expectedTextDoubled)
+{
+    MyString text("Tekst dluzszy niz dwadziescia znakow");
+    text += text;
+    EXPECT_EQ(string("Tekst dluzszy niz dwadziescia znakowTekst dluzszy niz dwadziescia znakow"), text.toString());
+}
+
 // use: std::all_of
 TEST_F(MyStringTester, all_of)
 {
@@ -406,3 +699,231 @@ TEST_F(MyStringTester, all_of)
     EXPECT_FALSE(onlyNumbers.all_of(::isalpha));
     EXPECT_FALSE(onlyNumbers.all_of(::isspace));
 }
+
+TEST_F(MyStringTester, countingWords_wordCrossingInlineBufferBorder_expectedOneWord)
+{
+    const string text = string(MyString::initialBufferSize_ - 3, ' ') + "Przekraczajace slowo";
+    const map<MyString,size_t> wordsUsage = MyString(text.c_str()).countWordsUsageIgnoringCases();
+
+    ASSERT_EQ(2, wordsUsage.size());
+    EXPECT_EQ(1, wordsUsage.at("przekraczajace"));
+    EXPECT_EQ(1, wordsUsage.at("slowo"));
+}
+
+TEST_F(MyStringTester, forEachWord_differentCharClasses_expectedDifferentWordDefinitions)
+{
+    const MyString line("max_size = get_value2(key) + 10;\tstatus=OK");
+
+    vector<string> identifiers, logTokens;
+    forEachWord<charclass::identifier>(line, [&](string_view word) { identifiers.emplace_back(word); });
+    forEachWord<charclass::nonWhitespace>(line, [&](string_view word) { logTokens.emplace_back(word); });
+
+    EXPECT_EQ((vector<string>{"max_size", "get_value2", "key", "10", "status", "OK"}), identifiers);
+    EXPECT_EQ((vector<string>{"max_size", "=", "get_value2(key)", "+", "10;", "status=OK"}), logTokens);
+}
+
+TEST_F(MyStringTester, appendNumber_inlineHeapAndCrossingBorder_expectedSameAsToString)
+{
+    MyString text;
+    string expected;
+    for (long long value: {0LL, -7LL, 123456789LL, numeric_limits<long long>::min(), numeric_limits<long long>::max()})
+    {
+        text.appendNumber(value).append(" ");
+        expected += to_string(value) + " ";
+        EXPECT_EQ(expected, text.toString());
+    }
+    text.appendNumber(255u, 16).appendNumber(static_cast<unsigned char>(7));
+    EXPECT_EQ(expected + "ff7", text.toString());
+    EXPECT_EQ(text.size(), text.toString().size());
+}
+
+TEST_F(MyStringTester, appendNumber_mostNegativeValueInBase2_expectedSignAndAllDigits)
+{
+    const string intMin = "-1" + string(31, '0');
+    const string longLongMin = "-1" + string(63, '0');
+    const string longText = "a text longer than the inline buffer ";
+
+    MyString inlineText("x");
+    inlineText.appendNumber(numeric_limits<int>::min(), 2);
+    EXPECT_EQ("x" + intMin, inlineText.toString());
+    MyString empty;
+    empty.appendNumber(numeric_limits<signed char>::min(), 2);
+    EXPECT_EQ("-10000000", empty.toString());
+
+    MyString heapText(longText.c_str());
+    heapText.appendNumber(numeric_limits<long long>::min(), 2).appendNumber(numeric_limits<int>::min(), 2);
+    EXPECT_EQ(longText + longLongMin + intMin, heapText.toString());
+    EXPECT_EQ(heapText.size(), heapText.toString().size());
+}
+
+TEST_F(MyStringTester, appendNumber_floatingPoint_expectedShortestRoundTripRepresentation)
+{
+    MyString text("x=");
+    text.appendNumber(0.1).append(";").appendNumber(1e300).append(";").appendNumber(-2.5f)
+        .append(";").appendNumber(1e20, chars_format::fixed);
+
+    EXPECT_EQ("x=0.1;1e+300;-2.5;100000000000000000000", text.toString());
+}
+
+TEST_F(MyStringTester, parseNumber_validAndInvalidContent_expectedValueOrNullopt)
+{
+    EXPECT_EQ(42, MyString("42").parseNumber<int>());
+    EXPECT_EQ(-17, MyString("-17").parseNumber<long>());
+    EXPECT_EQ(255, MyString("ff").parseNumber<int>(16));
+    EXPECT_EQ(0.25, MyString("0.25").parseNumber<double>());
+    EXPECT_EQ(12345678901234567890ull, MyString("00000000012345678901234567890").parseNumber<unsigned long long>());
+
+    EXPECT_FALSE(MyString("").parseNumber<int>());
+    EXPECT_FALSE(MyString(" 42").parseNumber<int>());
+    EXPECT_FALSE(MyString("42abc").parseNumber<int>());
+    EXPECT_FALSE(MyString("300").parseNumber<signed char>());
+    EXPECT_FALSE(MyString("-1").parseNumber<unsigned>());
+}
+
+TEST_F(MyStringTester, appendNumberThenParseNumber_expectedSameValue)
+{
+    for (const double value: {0.0, -1.5, 3.141592653589793, 6.02214076e23, 5e-324})
+    {
+        MyString text;
+        text.appendNumber(value);
+        EXPECT_EQ(value, text.parseNumber<double>());
+    }
+}
+
+#if defined(__cpp_lib_format)
+TEST_F(MyStringTester, stdFormat_withAndWithoutSpecification_expectedSameAsForStdString)
+{
+    const MyString shortText("short");
+    const MyString longText("a text longer than the inline buffer");
+
+    EXPECT_EQ("[short] [a text longer than the inline buffer]", format("[{}] [{}]", shortText, longText));
+    EXPECT_EQ("**short***|a text", format("{:*^10}|{:.6}", shortText, longText));
+    EXPECT_EQ(format("{:>40}", longText.toString()), format("{:>40}", longText));
+}
+
+TEST_F(MyStringTester, appendFormatted_inlineHeapAndCrossingBorder_expectedFormattedTextAppended)
+{
+    MyString text("id=");
+    text.appendFormatted("{}", 42);
+    EXPECT_EQ("id=42", text.toString());
+
+    text.appendFormatted(" name={:>12} value={:.3f}", "abc", 3.14159);
+    EXPECT_EQ("id=42 name=         abc value=3.142", text.toString());
+
+    text.appendFormatted("{}", MyString(" and a MyString longer than the buffer"));
+    EXPECT_EQ("id=42 name=         abc value=3.142 and a MyString longer than the buffer", text.toString());
+    EXPECT_EQ(text.size(), text.toString().size());
+
+    EXPECT_EQ("7 items", MyString::format("{} {}", 7, "items").toString());
+}
+#endif
+
+TEST_F(MyStringTester, operatorPlus_mixedOperands_expectedConcatenatedText)
+{
+    const MyString prefix("user:");
+    const MyString key("a key longer than the inline buffer");
+    const string value = "value";
+
+    const MyString joined = prefix + key + ":" + value;
+    EXPECT_EQ("user:a key longer than the inline buffer:value", joined.toString());
+    EXPECT_EQ(joined.size(), joined.toString().size());
+
+    const MyString shortJoined = "<" + MyString("x") + string_view(">");
+    EXPECT_EQ("<x>", shortJoined.toString());
+
+    const MyString grouped = (prefix + "[") + (key + "]");
+    EXPECT_EQ("user:[a key longer than the inline buffer]", grouped.toString());
+    EXPECT_EQ(6u, (prefix + "!").size());
+}
+
+TEST_F(MyStringTester, concat_anyNumberOfOperands_expectedConcatenatedText)
+{
+    EXPECT_TRUE(MyString::concat().empty());
+    EXPECT_EQ("one", MyString::concat("one").toString());
+    EXPECT_EQ("one two three 4", MyString::concat(MyString("one"), " ", string("two"), string_view(" three "),
+                                                 MyStringView{"4", {}}).toString());
+}
+
+namespace
+{
+using namespace mystring_literals;
+
+constexpr MyString constexprKey("klucz");
+constexpr std::array<MyString, 3> constexprTable{{MyString("alfa"), MyString("beta"), MyString("gamma")}};
+
+constexpr bool trimAndCaseAtCompileTime()
+{
+    MyString text("   Tekst dluzszy niz bufor wewnetrzny, wiec na stercie \t\n");
+    text.trim();
+    text.toLower();
+    MyString upper = "abc"_ms;
+    upper.toUpper();
+    return text.startsWith("tekst dluzszy") && text.endsWith("na stercie") && text.trimmed().size() == text.size()
+           && upper == "ABC"_ms;
+}
+
+constexpr bool appendCompareAndMoveAtCompileTime()
+{
+    MyString text = "ab"_ms;
+    text += 'c';
+    text.append(std::string_view(" - tekst przekraczajacy bufor"));
+    MyString moved(std::move(text));
+    MyString copy = moved;
+    return moved.size() == 32 && copy == moved && text.empty() && "abc"_ms < moved && moved <=> copy == 0
+           && MyString(3, 'x') == "xxx"_ms;
+}
+} // namespace
+
+TEST_F(MyStringTester, constexprString_expectedEvaluatedAtCompileTime)
+{
+    static_assert(constexprKey.size() == 5);
+    static_assert(constexprKey == "klucz"_ms && "klucz"_ms.size() == 5);
+    static_assert(constexprTable[1] < constexprTable[2]);
+    static_assert(std::ranges::is_sorted(constexprTable));
+    static_assert(trimAndCaseAtCompileTime());
+    static_assert(appendCompareAndMoveAtCompileTime());
+
+    EXPECT_TRUE(trimAndCaseAtCompileTime());
+    EXPECT_TRUE(appendCompareAndMoveAtCompileTime());
+    EXPECT_EQ("klucz", constexprKey.toString());
+}
+
+TEST_F(MyStringTester, hash_expectedSameValueAtCompileTimeAndRunTime)
+{
+    constexpr size_t shortHash = hash<MyString>{}("klucz"_ms);
+    constexpr size_t longHash = hash<MyString>{}("klucz dluzszy niz bufor wewnetrzny"_ms);
+
+    EXPECT_EQ(shortHash, hash<MyString>{}(MyString(string("klucz").c_str())));
+    EXPECT_EQ(longHash, hash<MyString>{}(MyString("klucz dluzszy niz bufor wewnetrzny")));
+    EXPECT_NE(shortHash, longHash);
+    EXPECT_NE(hash<MyString>{}("a"_ms), hash<MyString>{}("b"_ms));
+}
+
+TEST_F(MyStringTester, literal_expectedMyStringOfWholeLiteral)
+{
+    const MyString key = "klucz"_ms;
+    EXPECT_EQ(MyString("klucz"), key);
+    EXPECT_EQ(constexprKey, key);
+    EXPECT_EQ("literal dluzszy niz bufor wewnetrzny", ("literal dluzszy niz bufor wewnetrzny"_ms).toString());
+    EXPECT_EQ(string("a\0b", 3), ("a\0b"_ms).toString());
+}
+
+TEST_F(MyStringTester, equality_stringsWithDifferentHistory_expectedComparedByContent)
+{
+    MyString trimmed("  abc  ");
+    trimmed.trim();
+    MyString cleared("zawartosc przed wyczyszczeniem");
+    cleared.clear();
+    cleared.append(string_view("abc"));
+
+    EXPECT_EQ(MyString("abc"), trimmed);
+    EXPECT_EQ(trimmed, cleared);
+    EXPECT_NE(MyString("abd"), trimmed);
+}
+
+TEST_F(MyStringTester, comparison_bytesAbove127_expectedUnsignedOrderLikeStdString)
+{
+    const MyString ascii("z"), accented("\xC5\xBC"); // "ż" in UTF-8
+    EXPECT_LT(ascii, accented);
+    EXPECT_EQ(string("z") < string("\xC5\xBC"), ascii < accented);
+}
@@ -0,0 +1,125 @@
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#if __has_include("../mystringwriter.h")
+    #include "../mystringwriter.h"
+#elif __has_include("mystringwriter.h")
+    #include "mystringwriter.h"
+#else
+    #error "File 'mystringwriter.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+
+/// Temporary file, removed when closed.
+class TemporaryFile
+{
+public:
+    TemporaryFile() : file_(tmpfile()) {}
+    ~TemporaryFile() { fclose(file_); }
+
+    int fd() const { return fileno(file_); }
+
+    string content() const
+    {
+        string result;
+        char buffer[4096];
+        for (ssize_t read; (read = pread(fd(), buffer, sizeof buffer, static_cast<off_t>(result.size()))) > 0;)
+            result.append(buffer, static_cast<size_t>(read));
+        return result;
+    }
+
+private:
+    FILE* file_;
+};
+} // namespace
+
+
+class MyStringWriterTester : public ::testing::Test
+{
+};
+
+TEST_F(MyStringWriterTester, writeAll_expectedElementsWithSeparatorsAndTerminator)
+{
+    const vector<MyString> words{"short", "a text longer than the inline buffer", "", "end"};
+    TemporaryFile file;
+    MyStringWriter writer(file.fd());
+
+    writer.writeAll(words, ", ", ".\n");
+
+    EXPECT_EQ("short, a text longer than the inline buffer, , end.\n", file.content());
+    EXPECT_EQ(file.content().size(), writer.bytesWritten());
+    EXPECT_EQ(1u, writer.systemCalls());
+}
+
+TEST_F(MyStringWriterTester, emptyRange_expectedNothingWritten)
+{
+    TemporaryFile file;
+    MyStringWriter writer(file.fd());
+
+    writer.writeAll(vector<string>{});
+
+    EXPECT_EQ("", file.content());
+    EXPECT_EQ(0u, writer.systemCalls());
+}
+
+TEST_F(MyStringWriterTester, queuedWrites_expectedSentOnFlushOrDestruction)
+{
+    TemporaryFile file;
+    const MyString name("a string spilling to the heap");
+    {
+        MyStringWriter writer(file.fd());
+        writer.write(name).write(" = ").write(string_view("value")).write(MyStringView{"x", "y"});
+        EXPECT_EQ("", file.content());
+        writer.flush();
+        EXPECT_EQ("a string spilling to the heap = valuexy", file.content());
+        writer.write("\n");
+    }
+    EXPECT_EQ("a string spilling to the heap = valuexy\n", file.content());
+}
+
+TEST_F(MyStringWriterTester, manyStringsThroughPipe_expectedBatchesOfIovecsAndCompleteOutput)
+{
+    vector<MyString> lines;
+    string expected;
+    for (size_t i = 0; i < 100'000; ++i)
+    {
+        lines.push_back(MyString::generateRandomWord(i % 40));
+        expected.append(lines.back().toString()).append("\n");
+    }
+
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    string received;
+    thread reader([&] {
+        char buffer[1 << 16];
+        for (ssize_t read; (read = ::read(fds[0], buffer, sizeof buffer)) > 0;)
+            received.append(buffer, static_cast<size_t>(read));
+    });
+
+    MyStringWriter writer(fds[1]);
+    writer.writeAll(lines);
+    close(fds[1]);
+    reader.join();
+    close(fds[0]);
+
+    EXPECT_EQ(expected, received);
+    EXPECT_EQ(expected.size(), writer.bytesWritten());
+    EXPECT_GT(writer.systemCalls(), 100u);
+}
+
+TEST_F(MyStringWriterTester, invalidDescriptor_expectedSystemError)
+{
+    MyStringWriter writer(-1);
+    writer.write("text");
+    EXPECT_THROW(writer.flush(), std::system_error);
+}
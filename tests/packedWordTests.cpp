@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include <gtest/gtest.h>
+
+#if __has_include("../packedword.h")
+    #include "../packedword.h"
+#elif __has_include("packedword.h")
+    #include "packedword.h"
+#else
+    #error "File 'packedword.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+
+static_assert(sizeof(PackedLetters) == 20);
+static_assert(PackedLetters::pack("abc") < PackedLetters::pack("abd"));
+static_assert(PackedLetters::pack("ab") < PackedLetters::pack("abc"));
+static_assert(PackedLetters::pack("zz") > PackedLetters::pack("zaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+static_assert(!PackedLetters::pack("Abc") && !PackedLetters::pack("a-b") && PackedLetters::packIgnoringCase("Abc"));
+static_assert(!PackedLetters::pack("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+} // namespace
+
+
+class PackedWordTester : public ::testing::Test
+{
+};
+
+TEST_F(PackedWordTester, packAndUnpack_everyLengthUpTo32_expectedSameLetters)
+{
+    const string alphabet = "zyxwvutsrqponmlkjihgfedcbaabcdefghijklmnopqrstuvwxyz";
+    for (size_t length = 0; length <= PackedLetters::maxLength; ++length)
+    {
+        const string_view text = string_view(alphabet).substr(length % 20, length);
+        const auto packed = PackedLetters::pack(text);
+        ASSERT_TRUE(packed.has_value()) << text;
+        EXPECT_EQ(length, packed->size());
+        EXPECT_EQ(MyString(text), packed->toMyString());
+        for (size_t i = 0; i < length; ++i)
+            EXPECT_EQ(text[i], (*packed)[i]);
+    }
+}
+
+TEST_F(PackedWordTester, wordsOf21To32Letters_expectedPackedWithoutAllocation)
+{
+    if (!allocations::enabled())
+        GTEST_SKIP() << "built without MYSTRING_COUNT_ALLOCATIONS";
+
+    const allocations::Scope scope;
+    const PackedWord word("antidisestablishmentarianism");
+    const PackedWord copy = word;
+    EXPECT_EQ(0u, scope.heap().allocations);
+    EXPECT_TRUE(copy.isPacked());
+    EXPECT_EQ(28u, copy.size());
+    EXPECT_EQ('z', PackedWord("abcdefghijklmnopqrstuvwxyzabcdez")[31]);
+}
+
+TEST_F(PackedWordTester, otherContent_expectedKeptAsMyString)
+{
+    for (const string_view text: {"Capital", "with space", "cafe\xcc\x81", "thirtythreelettersaaaaaaaaaaaaaaa"})
+    {
+        const PackedWord word(text);
+        EXPECT_FALSE(word.isPacked()) << text;
+        EXPECT_EQ(MyString(text), word.toMyString());
+        EXPECT_EQ(text.size(), word.size());
+    }
+}
+
+TEST_F(PackedWordTester, ordering_mixedRepresentations_expectedSameAsMyString)
+{
+    const vector<string> texts{"", "a", "ab", "abc", "b", "zz", "Zebra", "a b", "\xe9t\xe9",
+                               "abcdefghijklmnopqrstuvwxyzabcdef", "abcdefghijklmnopqrstuvwxyzabcdefg",
+                               "abcdefghijklmnopqrstuvwxyzabcdeg"};
+    for (const string& lhs: texts)
+    {
+        for (const string& rhs: texts)
+        {
+            const PackedWord packedLhs(lhs), packedRhs(rhs);
+            EXPECT_EQ(MyString(lhs.c_str()) <=> MyString(rhs.c_str()), packedLhs <=> packedRhs) << lhs << " " << rhs;
+            EXPECT_EQ(lhs == rhs, packedLhs == packedRhs);
+        }
+    }
+}
+
+TEST_F(PackedWordTester, wordHelpers_expectedSameWordsAsMyString)
+{
+    const MyString text("The Pneumonoultramicroscopicsilicovolcanoconiosis of the THE floccinaucinihilipilification");
+    const auto packedWords = packedwords::getUniqueWords(text);
+    const auto words = text.getUniqueWords();
+    ASSERT_EQ(words.size(), packedWords.size());
+    EXPECT_TRUE(equal(words.begin(), words.end(), packedWords.begin(),
+                      [](const MyString& word, const PackedWord& packed) { return word == packed.toMyString(); }));
+
+    const auto counts = packedwords::countWordsUsageIgnoringCases(text);
+    EXPECT_EQ(3u, counts.at(PackedWord("the")));
+    EXPECT_FALSE(counts.find(PackedWord("pneumonoultramicroscopicsilicovolcanoconiosis"))->first.isPacked());
+    EXPECT_TRUE(counts.find(PackedWord("floccinaucinihilipilification"))->first.isPacked());
+}
+
+TEST_F(PackedWordTester, hashAndOutput_expectedByContent)
+{
+    unordered_set<PackedWord> set{PackedWord("packed"), PackedWord("Not packed")};
+    EXPECT_TRUE(set.contains(PackedWord(MyString("packed"))));
+    EXPECT_TRUE(set.contains(PackedWord("Not packed")));
+
+    ostringstream out;
+    out << PackedWord("packed") << '|' << PackedWord("Not packed");
+    EXPECT_EQ("packed|Not packed", out.str());
+}
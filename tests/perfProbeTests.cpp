@@ -0,0 +1,64 @@
+#include <string>
+#include <gtest/gtest.h>
+
+#if __has_include("../perfprobe.h")
+    #include "../perfprobe.h"
+    #include "../mystring.h"
+#elif __has_include("perfprobe.h")
+    #include "perfprobe.h"
+    #include "mystring.h"
+#else
+    #error "File 'perfprobe.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+} // namespace
+
+
+class PerfProbeTester : public ::testing::Test
+{
+};
+
+TEST_F(PerfProbeTester, probeAroundWork_expectedCountersOrGracefulZeros)
+{
+    const MyString text(100'000, 'a');
+    PerfReading counters;
+    size_t found = 0;
+    for (int repetition = 0; repetition < 3; ++repetition) {
+        PerfProbe probe(counters);
+        found += text.find_all("aaa").size();
+    }
+    EXPECT_EQ(3u * (100'000 - 2), found);
+
+    if (PerfCounters::hardwareAvailable()) {
+        EXPECT_GT(counters.instructions, 100'000u);
+        EXPECT_GT(counters.cycles, 0u);
+        EXPECT_GT(counters.instructionsPerCycle(), 0.0);
+        EXPECT_TRUE(PerfCounters::unavailableReason().empty());
+    } else {
+        EXPECT_EQ(0u, counters.cycles);
+        EXPECT_EQ(0u, counters.instructions);
+        EXPECT_EQ(0.0, counters.instructionsPerCycle());
+        EXPECT_FALSE(PerfCounters::unavailableReason().empty());
+    }
+    if (PerfCounters::softwareAvailable()) {
+        EXPECT_GT(counters.taskClockNs, 0u);
+    }
+}
+
+TEST_F(PerfProbeTester, readingArithmetic_expectedFieldByField)
+{
+    PerfReading total{10, 20, 3, 4, 1000};
+    total += PerfReading{5, 5, 1, 1, 500};
+    const PerfReading difference = total - PerfReading{15, 0, 4, 0, 0};
+
+    EXPECT_EQ(0u, difference.cycles);
+    EXPECT_EQ(25u, difference.instructions);
+    EXPECT_EQ(0u, difference.cacheMisses);
+    EXPECT_EQ(5u, difference.branchMisses);
+    EXPECT_EQ(1500u, difference.taskClockNs);
+    EXPECT_DOUBLE_EQ(25.0 / 15.0, total.instructionsPerCycle());
+}
@@ -0,0 +1,43 @@
+#include <vector>
+#include <gtest/gtest.h>
+
+#if __has_include("../prefixset.h")
+    #include "../prefixset.h"
+#elif __has_include("prefixset.h")
+    #include "prefixset.h"
+#else
+    #error "File 'prefixset.h' not found!"
+#endif
+
+namespace
+{
+using namespace std;
+using namespace ::testing;
+} // namespace
+
+
+class PrefixSetTester : public ::testing::Test
+{
+};
+
+TEST_F(PrefixSetTester, routingTable_expectedLongestMatchingPrefix)
+{
+    const PrefixSet routes({"/api", "/api/v1/", "/api/v1/users/", "/static/", "/api/v2/"});
+
+    EXPECT_EQ(2, routes.longestPrefixOf(MyString("/api/v1/users/12345/settings")));
+    EXPECT_EQ(1, routes.longestPrefixOf(MyString("/api/v1/orders")));
+    EXPECT_EQ(0, routes.longestPrefixOf(MyString("/api")));
+    EXPECT_EQ(PrefixSet::npos, routes.longestPrefixOf(MyString("/ap")));
+    EXPECT_EQ(PrefixSet::npos, routes.longestPrefixOf(MyString("/index.html")));
+    EXPECT_EQ((vector<size_t>{0, 1, 2}), routes.allPrefixesOf(MyString("/api/v1/users/")));
+}
+
+TEST_F(PrefixSetTester, fileExtensions_expectedAllMatchingSuffixes)
+{
+    const PrefixSet extensions({".gz", ".tar.gz", "z", ".txt", ""});
+
+    EXPECT_EQ((vector<size_t>{4, 2, 0, 1}), extensions.allSuffixesOf(MyString("dane_z_pomiarow_2024.tar.gz")));
+    EXPECT_EQ(1, extensions.longestSuffixOf(MyString("dane_z_pomiarow_2024.tar.gz")));
+    EXPECT_EQ(4, extensions.longestSuffixOf(MyString("notatki.md")));
+    EXPECT_EQ(3, extensions.longestSuffixOf(MyStringView{"notatki", ".txt"}));
+}
@@ -0,0 +1,124 @@
+// Reads a MyString statistics dump (stringstats::dumpText(), e.g. written at exit thanks to MYSTRING_STATS_FILE)
+// and estimates for every candidate inline capacity how many heap allocations and how much memory
+// the recorded constructions would need. Recommends the capacity with the lowest
+//     memory + allocation cost * heap allocations,
+// which can be then set with: cmake -DMYSTRING_INLINE_CAPACITY=<capacity> ..
+//
+// Usage: inline_capacity_recommender <dump file> [--allocation-cost BYTES] [--max-capacity N]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "mystringstats.h"
+
+namespace {
+
+struct Estimate {
+    std::size_t capacity;
+    double heapAllocations;
+    double bytes;
+    double score;
+};
+
+constexpr std::size_t roundUp(std::size_t value, std::size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+/// Layout of MyString: inline array, std::string for the rest, capacity and size.
+std::size_t objectSize(std::size_t capacity) {
+    return roundUp(capacity, alignof(std::string)) + sizeof(std::string) + 2 * sizeof(std::size_t);
+}
+
+/// Heap memory for the part which does not fit inline (std::string has its own small buffer too).
+/// Chunk sizes like in glibc malloc: 8 bytes of header, multiples of 16, at least 32.
+std::size_t heapChunk(std::size_t tailLength) {
+    static const std::size_t stdStringInline = std::string().capacity();
+    if (tailLength <= stdStringInline)
+        return 0;
+    return std::max<std::size_t>(32, roundUp(tailLength + 1 + 8, 16));
+}
+
+Estimate estimate(const stringstats::Snapshot& stats, std::size_t capacity, double allocationCost) {
+    Estimate result{capacity, 0, 0, 0};
+    for (std::size_t length = 0; length < stringstats::exactLengths; ++length) {
+        const auto count = static_cast<double>(stats.lengthCounts[length]);
+        if (count == 0)
+            continue;
+        const std::size_t chunk = heapChunk(length > capacity ? length - capacity : 0);
+        result.heapAllocations += chunk != 0 ? count : 0;
+        result.bytes += count * static_cast<double>(objectSize(capacity) + chunk);
+    }
+    if (stats.longerCount != 0) {
+        const auto count = static_cast<double>(stats.longerCount);
+        const double averageLength = static_cast<double>(stats.longerTotalLength) / count;
+        result.heapAllocations += count;
+        result.bytes += count * (static_cast<double>(objectSize(capacity)) + averageLength - static_cast<double>(capacity) + 16);
+    }
+    result.score = result.bytes + allocationCost * result.heapAllocations;
+    return result;
+}
+
+void printEstimate(const Estimate& estimate, double constructions, const char* note) {
+    std::cout << std::setw(9) << estimate.capacity << std::setw(12) << objectSize(estimate.capacity)
+              << std::setw(16) << std::setprecision(1) << 100.0 * estimate.heapAllocations / constructions
+              << std::setw(16) << std::setprecision(1) << estimate.bytes / constructions
+              << "  " << note << '\n';
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <dump file> [--allocation-cost BYTES] [--max-capacity N]\n";
+        return EXIT_FAILURE;
+    }
+    double allocationCost = 64;
+    std::size_t maxCapacity = 128;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        const std::string name = argv[i];
+        if (name == "--allocation-cost")
+            allocationCost = std::stod(argv[i + 1]);
+        else if (name == "--max-capacity")
+            maxCapacity = std::min<std::size_t>(std::stoul(argv[i + 1]), stringstats::exactLengths - 1);
+    }
+
+    std::ifstream in(argv[1]);
+    const auto stats = stringstats::parseText(in);
+    if (!stats || stats->constructions() == 0) {
+        std::cerr << "No statistics in " << argv[1] << " (was the program built with MYSTRING_COLLECT_STATS?)\n";
+        return EXIT_FAILURE;
+    }
+    const auto constructions = static_cast<double>(stats->constructions());
+
+    std::cout << "Constructions: " << stats->constructions() << ", spills by appending: " << stats->spills
+              << ", heap allocations: " << stats->heapAllocations << ", reallocations: " << stats->reallocations
+              << ", longest string: " << stats->maxLength << "\n\n"
+              << std::setw(9) << "capacity" << std::setw(12) << "sizeof" << std::setw(16) << "% allocating"
+              << std::setw(16) << "bytes/string" << '\n'
+              << std::fixed;
+
+    Estimate best = estimate(*stats, 1, allocationCost);
+    for (std::size_t capacity = 1; capacity <= maxCapacity; ++capacity) {
+        const Estimate current = estimate(*stats, capacity, allocationCost);
+        if (current.score < best.score)
+            best = current;
+    }
+    for (std::size_t capacity = 8; capacity <= maxCapacity; capacity += 8) {
+        if (capacity != best.capacity && capacity != stats->inlineCapacity)
+            printEstimate(estimate(*stats, capacity, allocationCost), constructions, "");
+    }
+    if (stats->inlineCapacity != best.capacity)
+        printEstimate(estimate(*stats, stats->inlineCapacity, allocationCost), constructions, "<- current");
+    printEstimate(best, constructions, stats->inlineCapacity == best.capacity ? "<- current, recommended"
+                                                                               : "<- recommended");
+
+    std::cout << "\nRecommended: -DMYSTRING_INLINE_CAPACITY=" << best.capacity
+              << " (allocation counted as " << allocationCost << " bytes)\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#ifndef WORDTOKENIZER_H
+#define WORDTOKENIZER_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "mystring.h"
+
+
+/// Set of bytes described by a 256-entry lookup table, built at compile time.
+struct CharClass {
+    std::array<bool, 256> members{};
+
+    template<typename Predicate>
+    static constexpr CharClass fromPredicate(Predicate predicate) {
+        CharClass result;
+        for (std::size_t ch = 0; ch < result.members.size(); ++ch)
+            result.members[ch] = predicate(static_cast<unsigned char>(ch));
+        return result;
+    }
+
+    static constexpr CharClass of(std::string_view chars) {
+        CharClass result;
+        for (const char ch: chars)
+            result.members[static_cast<unsigned char>(ch)] = true;
+        return result;
+    }
+
+    [[nodiscard]] constexpr bool contains(char ch) const {
+        return members[static_cast<unsigned char>(ch)];
+    }
+
+    [[nodiscard]] constexpr CharClass complement() const {
+        CharClass result;
+        for (std::size_t ch = 0; ch < members.size(); ++ch)
+            result.members[ch] = !members[ch];
+        return result;
+    }
+};
+
+namespace charclass {
+
+inline constexpr CharClass whitespace = CharClass::of(" \t\n\v\f\r");
+
+/// Same definition as std::isalpha in the "C" locale.
+inline constexpr CharClass letters = CharClass::fromPredicate([](unsigned char ch) {
+    return ('a' <= ch && ch <= 'z') || ('A' <= ch && ch <= 'Z');
+});
+
+inline constexpr CharClass identifier = CharClass::fromPredicate([](unsigned char ch) {
+    return letters.contains(static_cast<char>(ch)) || ('0' <= ch && ch <= '9') || ch == '_';
+});
+
+inline constexpr CharClass nonWhitespace = whitespace.complement();
+
+} // namespace charclass
+
+
+/// Calls onWord(std::string_view) for every maximal run of characters belonging to WordChars.
+template<CharClass WordChars, typename Callback>
+void forEachWord(std::string_view text, Callback&& onWord) {
+    const char* const data = text.data();
+    const std::size_t length = text.size();
+
+    std::size_t i = 0;
+    while (i < length) {
+        while (i < length && !WordChars.contains(data[i]))
+            ++i;
+        const std::size_t wordBegin = i;
+        while (i < length && WordChars.contains(data[i]))
+            ++i;
+        if (i > wordBegin)
+            onWord(std::string_view(data + wordBegin, i - wordBegin));
+    }
+}
+
+/// The inline and heap parts are scanned separately, only a word crossing the border is stitched together.
+template<CharClass WordChars, typename Callback>
+void forEachWord(const MyStringView& text, Callback&& onWord) {
+    const std::string_view head = text.head;
+    const std::string_view tail = text.tail;
+    if (tail.empty()) {
+        forEachWord<WordChars>(head, onWord);
+        return;
+    }
+
+    std::size_t headWordsEnd = head.size();
+    while (headWordsEnd > 0 && WordChars.contains(head[headWordsEnd - 1]))
+        --headWordsEnd;
+    std::size_t tailWordsBegin = 0;
+    while (tailWordsBegin < tail.size() && WordChars.contains(tail[tailWordsBegin]))
+        ++tailWordsBegin;
+
+    forEachWord<WordChars>(head.substr(0, headWordsEnd), onWord);
+    if (headWordsEnd < head.size() || tailWordsBegin > 0) {
+        std::string crossingWord(head.substr(headWordsEnd));
+        crossingWord.append(tail.substr(0, tailWordsBegin));
+        onWord(std::string_view(crossingWord));
+    }
+    forEachWord<WordChars>(tail.substr(tailWordsBegin), onWord);
+}
+
+template<CharClass WordChars, typename Callback>
+void forEachWord(const MyString& text, Callback&& onWord) {
+    forEachWord<WordChars>(text.view(), onWord);
+}
+
+
+#endif //WORDTOKENIZER_H